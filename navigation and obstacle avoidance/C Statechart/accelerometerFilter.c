@@ -0,0 +1,30 @@
+/** \file accelerometerFilter.c
+ *
+ * Low-pass filter for the accelerometer.
+ */
+
+#include "accelerometerFilter.h"
+#include <math.h>
+
+void accelerometerFilterInit(accelerometerFilter_t * const pFilter, const double alpha){
+	pFilter->alpha = alpha;
+	pFilter->alphaTick = alpha;
+	pFilter->periodMs = STATECHART_PERIOD_DRIVE_MS;
+	pFilter->value.x = 0;
+	pFilter->value.y = 0;
+	pFilter->value.z = 0;
+}
+
+accelerometer_t accelerometerFilterUpdate(accelerometerFilter_t * const pFilter, const accelerometer_t sample, const uint32_t periodMs){
+	// the period only changes with the statechart state; avoid pow() on every sample
+	if(periodMs != pFilter->periodMs && periodMs > 0){
+		pFilter->periodMs = periodMs;
+		pFilter->alphaTick = 1 - pow(1 - pFilter->alpha, (double)periodMs / STATECHART_PERIOD_DRIVE_MS);
+	}
+
+	pFilter->value.x = pFilter->alphaTick * sample.x + (1 - pFilter->alphaTick) * pFilter->value.x;
+	pFilter->value.y = pFilter->alphaTick * sample.y + (1 - pFilter->alphaTick) * pFilter->value.y;
+	pFilter->value.z = pFilter->alphaTick * sample.z + (1 - pFilter->alphaTick) * pFilter->value.z;
+
+	return pFilter->value;
+}
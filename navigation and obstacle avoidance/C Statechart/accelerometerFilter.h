@@ -0,0 +1,35 @@
+/** \file accelerometerFilter.h
+ *
+ * Low-pass filter for the accelerometer, shared by every target that feeds
+ * the statechart.
+ */
+
+#ifndef ACCELEROMETERFILTER_H_
+#define ACCELEROMETERFILTER_H_
+
+#include "irobotNavigationStatechart.h"
+
+/// Exponential moving average of the accelerometer axes.
+typedef struct{
+	double				alpha;			///< filter coefficient at the nominal loop period
+	double				alphaTick;		///< filter coefficient for periodMs
+	uint32_t			periodMs;		///< period alphaTick was computed for, in ms
+	accelerometer_t		value;			///< filtered value, in g
+} accelerometerFilter_t;
+
+/// Initialize a filter with zero output.
+void accelerometerFilterInit(
+	accelerometerFilter_t * const	pFilter,	///< [out] filter
+	const double					alpha		///< [in] filter coefficient at STATECHART_PERIOD_DRIVE_MS
+);
+
+/// Filter one accelerometer sample. The coefficient is rescaled so that the
+/// time constant of the filter does not depend on the loop period.
+/// \returns filtered value, in g
+accelerometer_t accelerometerFilterUpdate(
+	accelerometerFilter_t * const	pFilter,	///< [in,out] filter
+	const accelerometer_t			sample,		///< [in] raw accelerometer, in g
+	const uint32_t					periodMs	///< [in] time since the previous sample, in ms
+);
+
+#endif // ACCELEROMETERFILTER_H_
@@ -0,0 +1,45 @@
+#!/bin/sh
+# This script compiles a C Statechart into a shared library for Linux hosts
+# that load the statechart at runtime (target/plugin). It is the Linux
+# counterpart of csccompile.bat.
+#
+# Dependencies:
+#	A C compiler (cc)
+#	irobot headers in ../irobot
+#
+# Usage:
+#	csccompile.sh <path to C statechart> <path to output compiled library>
+#
+# How it works:
+#	1. Compiles the C Statechart as position-independent code against the
+#	   statechart header in this directory, together with the modules a
+#	   statechart may use (missions); add -DSTATECHART_COVERAGE to CFLAGS to
+#	   count transitions. The coverage registry is not linked into the
+#	   library: the host links irobotStatechartCoverage.c and exports it
+#	   (-rdynamic), so that counts survive a reload and are written once,
+#	   when the host exits
+#	2. Writes logfile with the same name of the output library and the ".log" extension
+#	3. Renames the library into place, so that a running host never loads a
+#	   partially written library; the host picks up the new library between ticks
+
+SCRIPTDIR=$(cd "$(dirname "$0")" && pwd)
+USAGEMSG="Usage: csccompile.sh (path to C statechart source) (path to save compiled library)"
+CC=${CC:-cc}
+
+# Verify path to source.
+if [ $# -lt 2 ]; then echo "Not enough arguments."; echo "$USAGEMSG"; exit 1; fi
+if [ ! -f "$1" ]; then echo "File not found: $1"; exit 1; fi
+echo "Compiling $1 into $2:"
+
+# compile next to the output so that the rename is atomic
+if ! $CC -std=gnu99 -O2 -fPIC -shared $CFLAGS \
+		-I"$SCRIPTDIR" -I"$SCRIPTDIR/../irobot" -I"$(dirname "$1")" \
+		-o "$2.tmp" "$1" "$SCRIPTDIR/irobotMission.c" -lm > "$2.log" 2>&1; then
+	cat "$2.log"
+	echo "Build failed."
+	rm -f "$2.tmp"
+	exit 1
+fi
+
+mv -f "$2.tmp" "$2"
+echo "Build succeeded."
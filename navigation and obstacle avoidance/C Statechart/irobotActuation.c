@@ -0,0 +1,91 @@
+/** \file irobotActuation.c
+ *
+ * Actuation stage between the statechart and the iRobot.
+ */
+
+#include "irobotActuation.h"
+#include <stdlib.h>
+
+/// Move a wheel speed toward its target, limiting only increases in speed.
+static int16_t actuationSlew(const int16_t current, const int16_t target, const int32_t maxStep){
+	if(maxStep <= 0){
+		return target;
+	}
+	else if((current >= 0) == (target >= 0) || current == 0){
+		// same direction (or starting from rest); slowing down is immediate
+		if(abs(target) <= abs(current) + maxStep){
+			return target;
+		}
+		return (int16_t)(current + (target > current ? maxStep : -maxStep));
+	}
+	else{
+		// reversing; stop at once, then accelerate in the new direction
+		if(abs(target) <= maxStep){
+			return target;
+		}
+		return (int16_t)(target > 0 ? maxStep : -maxStep);
+	}
+}
+
+void irobotActuationInit(irobotActuation_t * const pActuation, const uint32_t maxAcceleration, const uint32_t refreshMs){
+	pActuation->maxAcceleration = maxAcceleration;
+	pActuation->refreshMs = refreshMs;
+	pActuation->commanded = false;
+	pActuation->leftWheelSpeed = 0;
+	pActuation->rightWheelSpeed = 0;
+	pActuation->msSinceCommand = 0;
+	pActuation->nRequested = 0;
+	pActuation->nSent = 0;
+	pActuation->bytesDeduplicated = 0;
+}
+
+bool irobotActuationUpdate(
+	irobotActuation_t * const	pActuation,
+	const int16_t				leftWheelSpeed,
+	const int16_t				rightWheelSpeed,
+	const uint32_t				periodMs,
+	int16_t * const				pLeftWheelSpeed,
+	int16_t * const				pRightWheelSpeed
+){
+	// largest speed increase this period; at least 1 mm/s so that the target is always reached
+	int32_t maxStep = 0;
+	if(pActuation->maxAcceleration > 0){
+		maxStep = (int32_t)((uint64_t)pActuation->maxAcceleration * periodMs / 1000);
+		if(maxStep < 1){
+			maxStep = 1;
+		}
+	}
+
+	*pLeftWheelSpeed = actuationSlew(pActuation->leftWheelSpeed, leftWheelSpeed, maxStep);
+	*pRightWheelSpeed = actuationSlew(pActuation->rightWheelSpeed, rightWheelSpeed, maxStep);
+
+	pActuation->nRequested++;
+	pActuation->msSinceCommand += periodMs;
+
+	// the iRobot holds the last command; only send changes, and refresh in case a command was lost
+	if(   pActuation->commanded
+	   && *pLeftWheelSpeed == pActuation->leftWheelSpeed
+	   && *pRightWheelSpeed == pActuation->rightWheelSpeed
+	   && (pActuation->refreshMs == 0 || pActuation->msSinceCommand < pActuation->refreshMs)
+	){
+		pActuation->bytesDeduplicated += ACTUATION_DRIVE_DIRECT_SIZE;
+		return false;
+	}
+
+	pActuation->commanded = true;
+	pActuation->leftWheelSpeed = *pLeftWheelSpeed;
+	pActuation->rightWheelSpeed = *pRightWheelSpeed;
+	pActuation->msSinceCommand = 0;
+	pActuation->nSent++;
+
+	return true;
+}
+
+void irobotActuationInvalidate(irobotActuation_t * const pActuation){
+	pActuation->commanded = false;
+}
+
+void irobotActuationOverride(irobotActuation_t * const pActuation, const int16_t leftWheelSpeed, const int16_t rightWheelSpeed){
+	pActuation->leftWheelSpeed = leftWheelSpeed;
+	pActuation->rightWheelSpeed = rightWheelSpeed;
+}
@@ -0,0 +1,67 @@
+/** \file irobotActuation.h
+ *
+ * Actuation stage between the statechart and the iRobot: limits wheel
+ * acceleration and suppresses drive commands that would not change the
+ * wheel speeds, to save UART bandwidth. The control loop writes at most
+ * one drive command per tick, so there is nothing to batch within a tick;
+ * the saving comes from the duplicates alone.
+ */
+
+#ifndef IROBOTACTUATION_H_
+#define IROBOTACTUATION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/// Size of a Drive Direct command on the UART, in bytes
+#define ACTUATION_DRIVE_DIRECT_SIZE		5
+
+/// Actuation stage state
+typedef struct{
+	uint32_t	maxAcceleration;		///< largest increase in wheel speed, in mm/s^2; 0 disables the limit
+	uint32_t	refreshMs;				///< resend an unchanged command after this long, in ms; 0 never resends
+	bool		commanded;				///< a command has been sent since initialization
+	int16_t		leftWheelSpeed;			///< last commanded left wheel speed, in mm/s
+	int16_t		rightWheelSpeed;		///< last commanded right wheel speed, in mm/s
+	uint32_t	msSinceCommand;			///< time since the last command was sent, in ms
+	uint32_t	nRequested;				///< number of updates from the statechart
+	uint32_t	nSent;					///< number of drive commands sent
+	uint64_t	bytesDeduplicated;		///< UART bytes of drive commands suppressed as duplicates of the last one sent
+} irobotActuation_t;
+
+/// Initialize the actuation stage. No command has been sent, so the first
+/// update always produces one.
+void irobotActuationInit(
+	irobotActuation_t * const	pActuation,			///< [out] actuation stage
+	const uint32_t				maxAcceleration,	///< [in] largest increase in wheel speed, in mm/s^2; 0 disables
+	const uint32_t				refreshMs			///< [in] resend interval for an unchanged command, in ms; 0 never resends
+);
+
+/// Apply the acceleration limit to the wheel speeds requested by the statechart.
+/// Braking is not limited, so that reactions to obstacles are not delayed;
+/// a reversal stops the wheel at once and then accelerates it.
+/// \returns true if the command differs from the last one sent and must be written
+bool irobotActuationUpdate(
+	irobotActuation_t * const	pActuation,			///< [in,out] actuation stage
+	const int16_t				leftWheelSpeed,		///< [in] requested left wheel speed, in mm/s
+	const int16_t				rightWheelSpeed,	///< [in] requested right wheel speed, in mm/s
+	const uint32_t				periodMs,			///< [in] time since the previous update, in ms
+	int16_t * const				pLeftWheelSpeed,	///< [out] left wheel speed to command, in mm/s
+	int16_t * const				pRightWheelSpeed	///< [out] right wheel speed to command, in mm/s
+);
+
+/// Forget the last command, e.g. after a UART error, so that the next update resends.
+void irobotActuationInvalidate(
+	irobotActuation_t * const	pActuation			///< [in,out] actuation stage
+);
+
+/// Record wheel speeds the iRobot took up without the actuation stage,
+/// e.g. from the stop at the end of a script, so that later commands are
+/// limited from, and compared against, the speeds the wheels actually have.
+void irobotActuationOverride(
+	irobotActuation_t * const	pActuation,			///< [in,out] actuation stage
+	const int16_t				leftWheelSpeed,		///< [in] left wheel speed, in mm/s
+	const int16_t				rightWheelSpeed		///< [in] right wheel speed, in mm/s
+);
+
+#endif // IROBOTACTUATION_H_
@@ -0,0 +1,177 @@
+/** \file irobotApp.c
+ *
+ * Control loop of the navigation application.
+ */
+
+#include "irobotApp.h"
+#include "accelerometerFilter.h"
+#include <stdio.h>
+#include <string.h>
+
+/// Keep the first error; otherwise keep the latest warning.
+static void appMergeStatus(int32_t * const pStatus, const int32_t newStatus){
+	if(*pStatus >= 0 && (newStatus < 0 || *pStatus == 0)){
+		*pStatus = newStatus;
+	}
+}
+
+/// Wait until the clock passes the next integer multiple of a period.
+/// Use to create periodic loops. This function will never delay more than
+///	msMultiple, but may delay less.
+static void appWaitUntilNextMsMultiple(const irobotHal_t * const pHal, const uint64_t msMultiple){
+	const uint64_t msCounter = pHal->timeMs(pHal->pContext) % msMultiple;
+	if(msCounter > 0){
+		pHal->delayMs(pHal->pContext, msMultiple - msCounter);
+	}
+}
+
+int32_t irobotAppRun(
+	const irobotHal_t * const			pHal,
+	irobotNavigationStatechart_t		statechart,
+	const irobotAppConfig_t * const		pConfig,
+	irobotAppStatistics_t * const		pStatistics
+){
+	// sensor inputs
+	irobotSensorGroup6_t	sensors;				///< irobot sensors
+	accelerometer_t			accelValue = {0,0,0};	///< accelerometer, in g
+	accelerometerFilter_t	accelFilter;			///< accelerometer low-pass filter
+
+	// actuator outputs
+	int16_t					leftWheelSpeed = 0;		///< speed of the left wheel, in mm/s
+	int16_t					rightWheelSpeed = 0;	///< speed of the right wheel, in mm/s
+	int16_t					leftWheelCommand = 0;	///< commanded speed of the left wheel, in mm/s
+	int16_t					rightWheelCommand = 0;	///< commanded speed of the right wheel, in mm/s
+
+	// maneuvers run as scripts
+	const bool				canScript = pConfig->maneuver && pConfig->scriptSegmentMs > 0 && pHal->uploadScript && pHal->playScript;
+	irobotManeuver_t		maneuver;				///< maneuver in progress
+	bool					scriptUpload;			///< the script of the segment must be uploaded
+	bool					scriptStop;				///< the segment stops the wheels
+	uint32_t				scriptMs = 0;			///< expected duration of the segment played this tick, in ms; 0 if none
+
+	// loop timing
+	uint32_t				periodMs = STATECHART_PERIOD_DRIVE_MS;	///< period requested by the statechart, in ms
+	uint32_t				elapsedMs = STATECHART_PERIOD_DRIVE_MS;	///< period of the current tick, in ms
+	uint64_t				msStart;				///< clock when the loop started, in ms
+
+	int32_t					status = 0;
+
+	memset(&sensors, 0, sizeof(sensors));
+	memset(pStatistics, 0, sizeof(*pStatistics));
+	accelerometerFilterInit(&accelFilter, pConfig->alpha);
+	irobotActuationInit(&pStatistics->actuation, pConfig->maxAcceleration, pConfig->driveRefreshMs);
+	irobotScriptInit(&pStatistics->script, pConfig->scriptSegmentMs);
+
+	// Read inputs, execute statechart, generate outputs, print debug information
+	msStart = pHal->timeMs(pHal->pContext);
+	while(status >= 0
+		  && !sensors.buttons.advance
+		  && (pConfig->durationMs == 0 || pHal->timeMs(pHal->pContext) - msStart < pConfig->durationMs)
+	){
+		// Read iRobot sensors
+		appMergeStatus(&status, pHal->readSensors(pHal->pContext, &sensors));
+		if(status >= 0){
+			// accumulate distance and angle
+			pStatistics->netDistance += sensors.distance;
+			pStatistics->netAngle += sensors.angle;
+		}
+
+		// Read and filter accelerometer
+		if(status >= 0){
+			appMergeStatus(&status, pHal->readAccelerometer(pHal->pContext, &accelValue));
+		}
+		if(status >= 0){
+			accelValue = accelerometerFilterUpdate(&accelFilter, accelValue, periodMs);
+		}
+
+		// Execute statechart
+		elapsedMs = periodMs;
+		periodMs = statechart(
+			pStatistics->netDistance,
+			pStatistics->netAngle,
+			sensors,
+			accelValue,
+			pConfig->isSimulator,
+			&rightWheelSpeed,
+			&leftWheelSpeed
+		);
+
+		// Produce outputs; unchanged commands are not resent
+		scriptMs = 0;
+		if(status >= 0
+		   && irobotActuationUpdate(&pStatistics->actuation, leftWheelSpeed, rightWheelSpeed, elapsedMs, &leftWheelCommand, &rightWheelCommand)
+		){
+			appMergeStatus(&status, pHal->driveDirect(pHal->pContext, leftWheelCommand, rightWheelCommand));
+		}
+		else if(status >= 0 && canScript){
+			// the wheels run at the speeds of the maneuver; let the iRobot end it
+			scriptMs = irobotScriptPlan(&pStatistics->script,
+										pConfig->maneuver(&maneuver) ? &maneuver : NULL,
+										pStatistics->netDistance,
+										pStatistics->netAngle,
+										&sensors,
+										leftWheelCommand,
+										rightWheelCommand,
+										&scriptUpload,
+										&scriptStop);
+			if(scriptMs > 0 && scriptUpload){
+				appMergeStatus(&status, pHal->uploadScript(pHal->pContext, pStatistics->script.script, pStatistics->script.scriptSize));
+			}
+			if(scriptMs > 0 && status >= 0){
+				appMergeStatus(&status, pHal->playScript(pHal->pContext));
+			}
+			if(scriptMs > 0 && scriptStop){
+				irobotActuationOverride(&pStatistics->actuation, 0, 0);
+			}
+		}
+
+		// print debug information
+		if(pConfig->verbose){
+			printf("\n\nx=%+.2f y=%+.2f z=%+.2f\nLWheel=%+3d RWheel=%+3d\n",
+					accelValue.x,
+					accelValue.y,
+					accelValue.z,
+					leftWheelCommand,
+					rightWheelCommand);
+		}
+
+		// Loop timing
+		if(periodMs == 0){
+			periodMs = STATECHART_PERIOD_DRIVE_MS;
+		}
+		if(pConfig->fixedPeriodMs > 0){
+			periodMs = pConfig->fixedPeriodMs;
+		}
+		pStatistics->nTicks++;
+		if(scriptMs > 0){
+			// the iRobot answers no query until the segment has ended
+			periodMs = scriptMs;
+			pHal->delayMs(pHal->pContext, scriptMs);
+		}
+		else{
+			appWaitUntilNextMsMultiple(pHal, periodMs);
+		}
+
+		if(pConfig->onTick){
+			pConfig->onTick(pConfig->pTickContext, &sensors, &statechart);
+		}
+	}
+
+	pStatistics->elapsedMs = pHal->timeMs(pHal->pContext) - msStart;
+	return status;
+}
+
+void irobotAppPrintStatistics(const irobotAppStatistics_t * const pStatistics){
+	printf("\n%u ticks in %llu ms\n", pStatistics->nTicks, (unsigned long long)pStatistics->elapsedMs);
+	printf("%u of %u drive commands sent, %llu UART bytes of duplicate commands saved\n",
+			pStatistics->actuation.nSent,
+			pStatistics->actuation.nRequested,
+			(unsigned long long)pStatistics->actuation.bytesDeduplicated);
+	if(pStatistics->script.nSegments > 0){
+		printf("%u script segments played, %u scripts uploaded, %u maneuvers handed back, %llu script bytes\n",
+				pStatistics->script.nSegments,
+				pStatistics->script.nUploads,
+				pStatistics->script.nFallbacks,
+				(unsigned long long)pStatistics->script.bytesSent);
+	}
+}
@@ -0,0 +1,73 @@
+/** \file irobotApp.h
+ *
+ * Control loop of the navigation application: read the sensors and the
+ * accelerometer, execute the statechart, produce the wheel commands, and
+ * wait for the period the statechart asks for. All hardware and timing
+ * goes through an irobotHal_t, so the loop runs unmodified on the myRIO and
+ * headless in virtual time.
+ *
+ * With a maneuver function and a segment duration configured, and a HAL
+ * that can run scripts, maneuvers that end at a known distance or angle are
+ * run as Open Interface scripts (irobotScript.h); the loop then only reads
+ * the sensors between segments.
+ */
+
+#ifndef IROBOTAPP_H_
+#define IROBOTAPP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "irobotHal.h"
+#include "irobotActuation.h"
+#include "irobotScript.h"
+#include "irobotNavigationStatechart.h"
+#include "irobotSensorTypes.h"
+
+/// Called after every tick; may replace the statechart
+typedef void (*irobotAppTickHook_t)(
+	void * const						pContext,		///< [in] hook context
+	const irobotSensorGroup6_t * const	pSensors,		///< [in] sensors read this tick
+	irobotNavigationStatechart_t * const pStatechart	///< [in,out] statechart executed next tick
+);
+
+/// Application configuration
+typedef struct{
+	double					alpha;				///< accelerometer filter coefficient, at the nominal loop period
+	uint32_t				maxAcceleration;	///< largest wheel acceleration, in mm/s^2
+	uint32_t				driveRefreshMs;		///< interval to resend an unchanged drive command, in ms
+	bool					isSimulator;		///< passed to the statechart
+	bool					verbose;			///< print the accelerometer and wheel commands every tick
+	uint64_t				durationMs;			///< stop after this long, in ms; 0 runs until the advance button
+	irobotAppTickHook_t		onTick;				///< called after every tick, or NULL
+	void *					pTickContext;		///< passed to onTick
+	irobotNavigationStatechartManeuver_t	maneuver;	///< maneuver of the statechart, or NULL to command every tick
+	uint32_t				scriptSegmentMs;	///< duration of a script segment, in ms; 0 commands every tick
+	uint32_t				fixedPeriodMs;		///< loop period, in ms, used instead of the one the statechart asks for; 0 to follow the statechart
+} irobotAppConfig_t;
+
+/// Application statistics
+typedef struct{
+	uint32_t				nTicks;				///< number of loop iterations executed
+	uint64_t				elapsedMs;			///< clock time spent in the loop, in ms
+	int32_t					netDistance;		///< net distance the robot has traveled, in mm
+	int32_t					netAngle;			///< net angle through which the robot has turned, in deg
+	irobotActuation_t		actuation;			///< drive command statistics
+	irobotScript_t			script;				///< script statistics
+} irobotAppStatistics_t;
+
+/// Run the control loop until the advance button is pressed, the duration
+/// has elapsed, or an error occurs.
+/// \returns status of the first error, or of the last operation
+int32_t irobotAppRun(
+	const irobotHal_t * const			pHal,			///< [in] hardware
+	irobotNavigationStatechart_t		statechart,		///< [in] statechart to execute
+	const irobotAppConfig_t * const		pConfig,		///< [in] configuration
+	irobotAppStatistics_t * const		pStatistics		///< [out] statistics
+);
+
+/// Print the loop statistics.
+void irobotAppPrintStatistics(
+	const irobotAppStatistics_t * const	pStatistics		///< [in] statistics
+);
+
+#endif // IROBOTAPP_H_
@@ -0,0 +1,52 @@
+/** \file irobotHal.h
+ *
+ * Hardware abstraction for the control loop in irobotApp.c: the clock,
+ * the iRobot on the UART and the accelerometer. The myRIO target
+ * implements it with the wall clock and the real peripherals; the headless
+ * target implements it with a virtual clock and a simulated robot, so that
+ * the same loop runs faster than real time.
+ *
+ * Functions return a status in the NiFpga convention: negative is an
+ * error, positive a warning, zero success.
+ */
+
+#ifndef IROBOTHAL_H_
+#define IROBOTHAL_H_
+
+#include <stdint.h>
+#include "irobotNavigationStatechart.h"
+#include "irobotSensorTypes.h"
+
+/// Hardware abstraction
+typedef struct{
+	void *		pContext;			///< passed to every function
+
+	/// \returns clock, in ms
+	uint64_t	(*timeMs)(void * const pContext);
+
+	/// Block for a time, in ms.
+	void		(*delayMs)(void * const pContext, const uint64_t ms);
+
+	/// Read sensor packet group 6 from the iRobot.
+	/// \returns status
+	int32_t		(*readSensors)(void * const pContext, irobotSensorGroup6_t * const pSensors);
+
+	/// Command the iRobot wheel speeds, in mm/s.
+	/// \returns status
+	int32_t		(*driveDirect)(void * const pContext, const int16_t leftWheelSpeed, const int16_t rightWheelSpeed);
+
+	/// Read the accelerometer, in g.
+	/// \returns status
+	int32_t		(*readAccelerometer)(void * const pContext, accelerometer_t * const pAccel);
+
+	/// Upload an Open Interface script to the iRobot, replacing the last one;
+	/// NULL if the hardware cannot run scripts.
+	/// \returns status
+	int32_t		(*uploadScript)(void * const pContext, const uint8_t * const script, const uint8_t size);
+
+	/// Play the uploaded script.
+	/// \returns status
+	int32_t		(*playScript)(void * const pContext);
+} irobotHal_t;
+
+#endif // IROBOTHAL_H_
@@ -0,0 +1,50 @@
+/** \file irobotHillClimb.h
+ *
+ * Accelerometer inputs and the climb controller of the hill-climb
+ * statechart, inline so that the statechart and the benchmark execute the
+ * same code.
+ */
+
+#ifndef IROBOTHILLCLIMB_H_
+#define IROBOTHILLCLIMB_H_
+
+#include "irobotNavigationStatechart.h"
+#include <math.h>
+
+#define HILLCLIMB_DEG_PER_RAD		(180.0 / M_PI)		///< degrees per radian
+#define HILLCLIMB_RAD_PER_DEG		(M_PI / 180.0)		///< radians per degree
+
+// Visual Studio 2013 compiles the simulator library as C89, which spells inline __inline
+#if defined(_MSC_VER) && !defined(__cplusplus)
+	#define HILLCLIMB_INLINE		static __inline
+#else
+	#define HILLCLIMB_INLINE		static inline
+#endif
+
+/// \returns inclination of the robot, in deg
+HILLCLIMB_INLINE double hillClimbInclination(
+	const accelerometer_t		accelAxes			///< [in] accelerometer, in g
+){
+	return sqrt(accelAxes.x*accelAxes.x + accelAxes.y*accelAxes.y) * 90.0;
+}
+
+/// \returns direction of the slope in the xy plane of the robot, in deg
+HILLCLIMB_INLINE double hillClimbTilt(
+	const accelerometer_t		accelAxes,			///< [in] accelerometer, in g
+	const double				tiltCorrection		///< [in] calibration of the xy orientation of the accelerometer, in deg
+){
+	return atan2(accelAxes.y, accelAxes.x) * HILLCLIMB_DEG_PER_RAD + tiltCorrection;
+}
+
+/// Proportional controller that steers the robot straight up the slope.
+HILLCLIMB_INLINE void hillClimbWheelSpeeds(
+	const int32_t				driveSpeed,			///< [in] speed on level ground, in mm/s
+	const double				tilt,				///< [in] tilt of the robot, in deg
+	int16_t * const				pRightWheelSpeed,	///< [out] right wheel speed, in mm/s
+	int16_t * const				pLeftWheelSpeed		///< [out] left wheel speed, in mm/s
+){
+	*pLeftWheelSpeed = (int16_t)(int32_t)((double)driveSpeed * cos((45 + tilt) * HILLCLIMB_RAD_PER_DEG));
+	*pRightWheelSpeed = (int16_t)(int32_t)((double)driveSpeed * sin((45 + tilt) * HILLCLIMB_RAD_PER_DEG));
+}
+
+#endif // IROBOTHILLCLIMB_H_
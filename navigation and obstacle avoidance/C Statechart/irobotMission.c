@@ -0,0 +1,45 @@
+/** \file irobotMission.c
+ *
+ * Maneuver sequences written as straight-line code.
+ */
+
+#include "irobotMission.h"
+
+void irobotMissionStart(irobotMission_t * const pMission, const uint32_t leg){
+	pMission->leg = leg;
+	pMission->legStarted = false;
+	pMission->done = false;
+	pMission->leftWheelSpeed = 0;
+	pMission->rightWheelSpeed = 0;
+	pMission->periodMs = STATECHART_PERIOD_DRIVE_MS;
+	pMission->legEnd = MANEUVER_NONE;
+	pMission->legTarget = 0;
+}
+
+bool irobotMissionManeuver(const irobotMission_t * const pMission, irobotManeuver_t * const pManeuver){
+	int64_t target;
+
+	// legs complete on the magnitude travelled; the direction of travel gives the sign
+	switch(pMission->done ? MANEUVER_NONE : pMission->legEnd){
+	case MANEUVER_DISTANCE:
+		target = pMission->leftWheelSpeed + pMission->rightWheelSpeed < 0 ? -(int64_t)pMission->legTarget : pMission->legTarget;
+		target += pMission->distanceAtLegStart;
+		break;
+	case MANEUVER_ANGLE:
+		target = pMission->rightWheelSpeed - pMission->leftWheelSpeed < 0 ? -(int64_t)pMission->legTarget : pMission->legTarget;
+		target += pMission->angleAtLegStart;
+		break;
+	default:
+		pManeuver->end = MANEUVER_NONE;
+		return false;
+	}
+
+	// e.g. a leg that drives until the next obstacle
+	if(target < INT32_MIN || target > INT32_MAX){
+		pManeuver->end = MANEUVER_NONE;
+		return false;
+	}
+	pManeuver->end = pMission->legEnd;
+	pManeuver->target = (int32_t)target;
+	return true;
+}
@@ -0,0 +1,174 @@
+/** \file irobotMission.h
+ *
+ * Missions: maneuver sequences written as straight-line code,
+ *
+ *	static void squareMission(irobotMission_t * const pMission){
+ *		MISSION_BEGIN(pMission);
+ *		MISSION_DRIVE(pMission, 800, 200);
+ *		MISSION_TURN_LEFT(pMission, 88, 100);
+ *		...
+ *		MISSION_END(pMission);
+ *	}
+ *
+ * and resumed once per statechart tick with irobotMissionResume(). As in a
+ * protothread, MISSION_BEGIN opens a switch on the current leg and each leg
+ * is a case of it, so a resume jumps straight to the current leg, which
+ * either sets the wheel speeds and returns, or completes and falls through
+ * to the next leg within the same tick. All state is in irobotMission_t,
+ * which the statechart allocates statically; the current leg is its place
+ * in the body, so a mission can be saved in a statechart context and
+ * survives a rebuild that does not add, remove or reorder legs.
+ *
+ * Legs are numbered from 1 in the order they appear in the body; leg 0 is
+ * the top of the body. A condition around a leg is evaluated when the
+ * mission reaches it, and is not evaluated again while the leg runs. Like
+ * any protothread, the body keeps nothing in local variables across
+ * resumes, and legs must not be placed inside a switch of the body.
+ *
+ * Pausing is done by not resuming the mission; an obstacle is handled by
+ * restarting it with irobotMissionStart().
+ */
+
+#ifndef IROBOTMISSION_H_
+#define IROBOTMISSION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "irobotNavigationStatechart.h"
+
+/// Mission state
+typedef struct{
+	uint32_t	leg;					///< number of the leg being executed; 0 before the first
+	bool		legStarted;				///< the current leg has recorded its start
+	bool		done;					///< all legs have completed
+	int32_t		netDistance;			///< net distance at this resume, in mm
+	int32_t		netAngle;				///< net angle at this resume, in deg
+	int32_t		distanceAtLegStart;		///< net distance when the current leg began, in mm
+	int32_t		angleAtLegStart;		///< net angle when the current leg began, in deg
+	int16_t		leftWheelSpeed;			///< left wheel speed requested by the current leg, in mm/s
+	int16_t		rightWheelSpeed;		///< right wheel speed requested by the current leg, in mm/s
+	uint32_t	periodMs;				///< loop period requested by the current leg, in ms
+	irobotManeuverEnd_t	legEnd;			///< what ends the current leg
+	int32_t		legTarget;				///< distance, in mm, or angle, in deg, that ends the current leg
+} irobotMission_t;
+
+/// Mission body; yields by returning
+typedef void (*irobotMissionFunction_t)(irobotMission_t * const pMission);
+
+/// Start, or restart, a mission at the given leg.
+void irobotMissionStart(
+	irobotMission_t * const			pMission,	///< [out] mission
+	const uint32_t					leg			///< [in] number of the first leg to execute; 0 runs the body from the top
+);
+
+// Visual Studio 2013 compiles the simulator library as C89, which spells inline __inline
+#if defined(_MSC_VER) && !defined(__cplusplus)
+	#define MISSION_INLINE			static __inline
+#else
+	#define MISSION_INLINE			static inline
+#endif
+
+/// Resume a mission for one tick. The wheel speeds and period of the
+/// current leg are left in the mission. Inline, so that the mission body
+/// is called directly, and can be inlined into the statechart.
+/// \returns false once every leg has completed
+MISSION_INLINE bool irobotMissionResume(
+	irobotMission_t * const			pMission,	///< [in,out] mission
+	const irobotMissionFunction_t	mission,	///< [in] mission body
+	const int32_t					netDistance,///< [in] net distance, in mm
+	const int32_t					netAngle	///< [in] net angle, in deg
+){
+	pMission->netDistance = netDistance;
+	pMission->netAngle = netAngle;
+	mission(pMission);
+
+	return !pMission->done;
+}
+
+/// Describe the current leg as a maneuver, for irobotNavigationStatechartManeuver().
+/// \returns false if the mission is done, or the leg is too long to end at a net distance or angle
+bool irobotMissionManeuver(
+	const irobotMission_t * const	pMission,	///< [in] mission
+	irobotManeuver_t * const		pManeuver	///< [out] maneuver
+);
+
+// a leg falls through to the next one; GCC 7 and later warn of that unless told
+#if defined(__GNUC__) && __GNUC__ >= 7
+	#define MISSION_FALLTHROUGH		__attribute__((fallthrough))
+#else
+	#define MISSION_FALLTHROUGH		((void)0)
+#endif
+
+/// First statement of a mission body; opens the switch on the current leg.
+#define MISSION_BEGIN(pMission)														\
+	enum{ missionLegBase = __COUNTER__ };											\
+	switch((pMission)->leg){														\
+	case 0:
+
+/// A leg that holds the wheel speeds until distance or angle travelled
+/// since the leg began satisfies the completion condition; end tells
+/// which of the two it is.
+#define MISSION_LEG(pMission, end, traveled, target, left, right, period)			\
+	MISSION_LEG_AT(__COUNTER__ - missionLegBase, pMission, end, traveled, target, left, right, period)
+
+/// A leg at a given place in the body, for MISSION_LEG().
+#define MISSION_LEG_AT(number, pMission, end, traveled, target, left, right, period)	\
+	do{																				\
+		(pMission)->leg = (number);													\
+		MISSION_FALLTHROUGH;														\
+	case (number):																	\
+		if(!(pMission)->legStarted){												\
+			(pMission)->distanceAtLegStart = (pMission)->netDistance;				\
+			(pMission)->angleAtLegStart = (pMission)->netAngle;						\
+			(pMission)->legStarted = true;											\
+		}																			\
+		if((traveled) < (target)){													\
+			(pMission)->leftWheelSpeed = (left);									\
+			(pMission)->rightWheelSpeed = (right);									\
+			(pMission)->periodMs = (period);										\
+			(pMission)->legEnd = (end);												\
+			(pMission)->legTarget = (target);										\
+			return;																	\
+		}																			\
+		(pMission)->legStarted = false;												\
+	}while(0)
+
+/// Distance travelled since the current leg began, in mm
+#define MISSION_DISTANCE(pMission)	abs((pMission)->netDistance - (pMission)->distanceAtLegStart)
+
+/// Angle turned since the current leg began, in deg
+#define MISSION_ANGLE(pMission)		abs((pMission)->netAngle - (pMission)->angleAtLegStart)
+
+/// Drive straight for a distance, in mm, at a speed, in mm/s.
+#define MISSION_DRIVE(pMission, distance, speed)									\
+	MISSION_LEG(pMission, MANEUVER_DISTANCE, MISSION_DISTANCE(pMission), distance, speed, speed, STATECHART_PERIOD_DRIVE_MS)
+
+/// Turn in place counter-clockwise through an angle, in deg, at a wheel speed, in mm/s.
+#define MISSION_TURN_LEFT(pMission, angle, speed)									\
+	MISSION_LEG(pMission, MANEUVER_ANGLE, MISSION_ANGLE(pMission), angle, -(speed), speed, STATECHART_PERIOD_MANEUVER_MS)
+
+/// Turn in place clockwise through an angle, in deg, at a wheel speed, in mm/s.
+#define MISSION_TURN_RIGHT(pMission, angle, speed)									\
+	MISSION_LEG(pMission, MANEUVER_ANGLE, MISSION_ANGLE(pMission), angle, speed, -(speed), STATECHART_PERIOD_MANEUVER_MS)
+
+/// Last statement of a mission body; stops the robot and closes the switch.
+/// A leg number past the end, e.g. from a context saved by a longer
+/// mission, ends the mission.
+#define MISSION_END(pMission)														\
+	MISSION_END_AT(__COUNTER__ - missionLegBase, pMission)
+
+/// End of the body at a given place, for MISSION_END().
+#define MISSION_END_AT(number, pMission)											\
+		(pMission)->leg = (number);													\
+		MISSION_FALLTHROUGH;														\
+	case (number):																	\
+	default:																		\
+		(pMission)->done = true;													\
+		(pMission)->leftWheelSpeed = 0;												\
+		(pMission)->rightWheelSpeed = 0;											\
+		(pMission)->periodMs = STATECHART_PERIOD_DRIVE_MS;							\
+		(pMission)->legEnd = MANEUVER_NONE;											\
+	}
+
+#endif // IROBOTMISSION_H_
@@ -5,8 +5,11 @@ As part of the CyberPhysical Systems program GoBearsX
 */
 
 #include "irobotNavigationStatechart.h"
+#include "irobotStatechartCoverage.h"
+#include "irobotMission.h"
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 /// Program States
 typedef enum{
@@ -14,17 +17,55 @@ typedef enum{
 	PAUSE_WAIT_BUTTON_RELEASE,			///< Paused; pause button pressed down, wait until released before detecting next press
 	UNPAUSE_WAIT_BUTTON_PRESS,			///< Paused; wait for pause button to be pressed
 	UNPAUSE_WAIT_BUTTON_RELEASE,		///< Paused; pause button pressed down, wait until released before returning to previous state
-	DRIVE,								///< Drive straight
-	DRIVE2,								///< Second Drive State
-	DRIVE3,								///< Third Drive State
-	DRIVE4,								///< Fourth Drive State
-	TURN,								///< Turn right
-	TURN2,								///< Second Turn right State
-	TURN_LEFT,							///< Turn Left State
-	TURN_LEFT2,							///< Second Turn Left State
+	RUN,								///< Executing the waypoint mission
 } robotState_t;
 
-void irobotNavigationStatechart(
+/// Legs of the waypoint mission
+typedef enum{
+	LEG_AVOID = 1,						///< Turn away from an obstacle; legs count from 1
+	LEG_WAYPOINTS						///< First waypoint leg
+} waypointLeg_t;
+
+// statechart state; exported through the context functions
+static robotState_t 		state = INITIAL;				// current program state
+static robotState_t			unpausedState = RUN;			// state history for pause region
+static irobotMission_t		mission;						// progress through the waypoint mission
+
+/// Statechart context, as exported to a host that reloads the statechart
+typedef struct{
+	uint32_t				tag;						// identifies this statechart and context layout
+	robotState_t			state;
+	robotState_t			unpausedState;
+	irobotMission_t			mission;
+} statechartContext_t;
+
+static const uint32_t contextTag = 0x57505434;	// "WPT4"
+
+// transition coverage, by program state
+static const char * const stateNames[] = {
+	"INITIAL",
+	"PAUSE_WAIT_BUTTON_RELEASE",
+	"UNPAUSE_WAIT_BUTTON_PRESS",
+	"UNPAUSE_WAIT_BUTTON_RELEASE",
+	"RUN"
+};
+STATECHART_COVERAGE_DEFINE("irobotWaypointStatechart", stateNames);
+
+/// Waypoints; after an obstacle, turn away from it and start over
+static void waypointMission(irobotMission_t * const pMission){
+	MISSION_BEGIN(pMission);
+	MISSION_TURN_RIGHT(pMission, 79, 100);		// LEG_AVOID
+	MISSION_DRIVE(pMission, 800, 200);			// LEG_WAYPOINTS
+	MISSION_TURN_LEFT(pMission, 88, 100);
+	MISSION_DRIVE(pMission, 1500, 200);
+	MISSION_TURN_LEFT(pMission, 89, 100);
+	MISSION_DRIVE(pMission, 1000, 200);
+	MISSION_TURN_RIGHT(pMission, 50, 100);
+	MISSION_DRIVE(pMission, INT32_MAX, 200);	// full speed ahead until the next obstacle
+	MISSION_END(pMission);
+}
+
+uint32_t IROBOT_STATECHART_SYMBOL(irobotWaypointStatechart, )(
 	const int32_t 				netDistance,
 	const int32_t 				netAngle,
 	const irobotSensorGroup6_t 	sensors,
@@ -33,15 +74,12 @@ void irobotNavigationStatechart(
 	int16_t * const 			pRightWheelSpeed,
 	int16_t * const 			pLeftWheelSpeed
 ){
-	// local state
-	static robotState_t 		state = INITIAL;				// current program state
-	static robotState_t			unpausedState = DRIVE;			// state history for pause region
-	static int32_t				distanceAtManeuverStart = 0;	// distance robot had travelled when a maneuver begins, in mm
-	static int32_t				angleAtManeuverStart = 0;		// angle through which the robot had turned when a maneuver begins, in deg
-
 	// outputs
 	int16_t						leftWheelSpeed = 0;				// speed of the left wheel, in mm/s
 	int16_t						rightWheelSpeed = 0;			// speed of the right wheel, in mm/s
+	uint32_t					periodMs = STATECHART_PERIOD_DRIVE_MS;	// period until the next execution, in ms
+
+	STATECHART_COVERAGE_FROM(state);
 
 	//*****************************************************
 	// state data - process inputs                        *
@@ -80,6 +118,7 @@ void irobotNavigationStatechart(
 			}
 			else{
 			}
+			irobotMissionStart(&mission, LEG_WAYPOINTS);
 			state = UNPAUSE_WAIT_BUTTON_PRESS; // place into pause state
 			break;
 		case PAUSE_WAIT_BUTTON_RELEASE:
@@ -110,58 +149,14 @@ void irobotNavigationStatechart(
 	//*************************************
 	// state transition - run region      *
 	//*************************************
-	/*else if (sensors.bumps_wheelDrops.bumpLeft != 0){
-		angleAtManeuverStart = netAngle;
-		distanceAtManeuverStart = netDistance;
-		state = TURN;
-	}*/
 	else if (sensors.wallSignal >= 0 && sensors.wall == 1 || sensors.bumps_wheelDrops.bumpLeft != 0){
-		angleAtManeuverStart = netAngle;					//	Changes the current state (aka netAngle) to the initial (aka angleAtManeuverStart)
-		distanceAtManeuverStart = netDistance;				//	Changes the current state (aka netDistance) to the initial (aka distanceAtManeuverStart)
-		state = TURN;
-	}
-	else if (state == TURN && abs(netAngle - angleAtManeuverStart) >= 79){
-		angleAtManeuverStart = netAngle;
-		distanceAtManeuverStart = netDistance;
-		state = DRIVE;
-	}
-	else if (state == DRIVE && abs(netDistance - distanceAtManeuverStart) >= 800){
-		angleAtManeuverStart = netAngle;
-		distanceAtManeuverStart = netDistance;
-		state = TURN_LEFT;
-	}
-	else if (state == TURN_LEFT && abs(netAngle - angleAtManeuverStart) >= 88){
-		angleAtManeuverStart = netAngle;
-		distanceAtManeuverStart = netDistance;
-		state = DRIVE2;
-	}
-	else if (state == DRIVE2 && abs(netDistance - distanceAtManeuverStart) >= 1500){
-		angleAtManeuverStart = netAngle;					
-		distanceAtManeuverStart = netDistance;				
-		state = TURN_LEFT2;
-	}
-	else if (state == TURN_LEFT2 && abs(netAngle - angleAtManeuverStart) >= 89){
-		angleAtManeuverStart = netAngle;
-		distanceAtManeuverStart = netDistance;
-		state = DRIVE3;
-	}
-	else if (state == DRIVE3 && abs(netDistance - distanceAtManeuverStart) >= 1000){
-		//angleAtManeuverStart = netAngle;
-		distanceAtManeuverStart = netDistance;
-		state = TURN2;
-	}
-	else if (state == TURN2 && abs(netAngle - angleAtManeuverStart) >= 50){
-		//angleAtManeuverStart = netAngle;
-		distanceAtManeuverStart = netDistance;
-		state = DRIVE4;
-	}
-	else if (state == DRIVE4 && abs(netDistance - distanceAtManeuverStart) >= 9000){
-		//angleAtManeuverStart = netAngle;
-		distanceAtManeuverStart = netDistance;
-		//state = TURN3;
+		// obstacle; restart the mission by turning away
+		irobotMissionStart(&mission, LEG_AVOID);
+		state = RUN;
 	}
+	// else, the mission advances through its legs
 
-	// else, no transitions are taken
+	STATECHART_COVERAGE_TO(state);
 
 	//*****************
 	//* state actions *
@@ -173,55 +168,68 @@ void irobotNavigationStatechart(
 	case UNPAUSE_WAIT_BUTTON_RELEASE:
 		// in pause mode, robot should be stopped
 		leftWheelSpeed = rightWheelSpeed = 0;
+		periodMs = STATECHART_PERIOD_PAUSE_MS;
 		break;
 
-	case DRIVE:
-		// full speed ahead!
-		leftWheelSpeed = rightWheelSpeed = 200;
+	case RUN:
+		irobotMissionResume(&mission, waypointMission, netDistance, netAngle);
+		leftWheelSpeed = mission.leftWheelSpeed;
+		rightWheelSpeed = mission.rightWheelSpeed;
+		periodMs = mission.periodMs;
 		break;
 
-	case DRIVE2:
-		// full speed ahead!
-		leftWheelSpeed = rightWheelSpeed = 200;
+	default:
+		// Unknown state
+		leftWheelSpeed = rightWheelSpeed = 0;
 		break;
+	}
 
-	case DRIVE3:
-		// full speed ahead!
-		leftWheelSpeed = rightWheelSpeed = 200;
-		break;
+	// write outputs
+	*pLeftWheelSpeed = leftWheelSpeed;
+	*pRightWheelSpeed = rightWheelSpeed;
 
-	case DRIVE4:
-		// full speed ahead!
-		leftWheelSpeed = rightWheelSpeed = 200;
-		break;
+	return periodMs;
+}
 
-	case TURN:
-		leftWheelSpeed = 100;
-		rightWheelSpeed = -leftWheelSpeed;
-		break;
+size_t IROBOT_STATECHART_SYMBOL(irobotWaypointStatechart, ContextSave)(void * const pContext, const size_t contextSize){
+	statechartContext_t context;
 
-	case TURN2:
-		leftWheelSpeed = 100;
-		rightWheelSpeed = -leftWheelSpeed;
-		break;
+	if(!pContext || contextSize < sizeof(context)){
+		return 0;
+	}
 
-	case TURN_LEFT:
-		leftWheelSpeed = -100;
-		rightWheelSpeed = -leftWheelSpeed;
-		break;
+	context.tag = contextTag;
+	context.state = state;
+	context.unpausedState = unpausedState;
+	context.mission = mission;
+	memcpy(pContext, &context, sizeof(context));
 
-	case TURN_LEFT2:
-		leftWheelSpeed = -100;
-		rightWheelSpeed = -leftWheelSpeed;
-		break;
+	return sizeof(context);
+}
 
-	default:
-		// Unknown state
-		leftWheelSpeed = rightWheelSpeed = 0;
-		break;
+bool IROBOT_STATECHART_SYMBOL(irobotWaypointStatechart, ContextRestore)(const void * const pContext, const size_t contextSize){
+	statechartContext_t context;
+
+	if(!pContext || contextSize != sizeof(context)){
+		return false;
 	}
 
-	// write outputs
-	*pLeftWheelSpeed = leftWheelSpeed;
-	*pRightWheelSpeed = rightWheelSpeed;
+	memcpy(&context, pContext, sizeof(context));
+	if(context.tag != contextTag){
+		return false;
+	}
+
+	state = context.state;
+	unpausedState = context.unpausedState;
+	mission = context.mission;
+
+	return true;
+}
+
+bool IROBOT_STATECHART_SYMBOL(irobotWaypointStatechart, Maneuver)(irobotManeuver_t * const pManeuver){
+	if(state != RUN){
+		pManeuver->end = MANEUVER_NONE;
+		return false;
+	}
+	return irobotMissionManeuver(&mission, pManeuver);
 }
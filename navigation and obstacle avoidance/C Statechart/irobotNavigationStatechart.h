@@ -8,6 +8,7 @@
 #define IROBOTNAVIGATIONSTATECHART_H_
 
 #define _USE_MATH_DEFINES
+#include <stddef.h>
 #include "irobotSensorTypes.h"
 
 /// accelerometer values
@@ -17,8 +18,25 @@ typedef struct{
 	double	z;							///< z axis, in g
 } accelerometer_t;
 
+/// Control loop periods requested by the statechart, in ms
+#define STATECHART_PERIOD_MANEUVER_MS	20		///< turning or avoiding; react quickly to reach the target angle or distance
+#define STATECHART_PERIOD_DRIVE_MS		60		///< driving; nominal loop period
+#define STATECHART_PERIOD_PAUSE_MS		120		///< paused; only the play button is polled, so a shorter press can be missed
+
+/// Name of a statechart function defined by a variant. A program links
+/// one variant as irobotNavigationStatechart(); with
+/// IROBOT_STATECHART_VARIANTS defined, each variant's functions are named
+/// after the variant instead, so that every variant can be linked into one
+/// program and selected at runtime (irobotStatechartVariants.h).
+#ifdef IROBOT_STATECHART_VARIANTS
+	#define IROBOT_STATECHART_SYMBOL(variant, suffix)	variant##suffix
+#else
+	#define IROBOT_STATECHART_SYMBOL(variant, suffix)	irobotNavigationStatechart##suffix
+#endif
+
 /// Architecture-independent C Statechart.
-void irobotNavigationStatechart(
+/// \returns period until the statechart should next be executed, in ms
+uint32_t irobotNavigationStatechart(
 	const int32_t 				netDistance,		///< [in] net distance, in mm
 	const int32_t 				netAngle,			///< [in] net angle, in deg
 	const irobotSensorGroup6_t	sensors,			///< [in] sensor stream size, in bytes
@@ -28,4 +46,55 @@ void irobotNavigationStatechart(
 	int16_t * const 			pLeftWheelSpeed		///< [out] left wheel speed, in mm/s
 );
 
+/// Pointer to a statechart, for hosts that choose the statechart at runtime
+typedef uint32_t (*irobotNavigationStatechart_t)(
+	const int32_t, const int32_t, const irobotSensorGroup6_t, const accelerometer_t,
+	const bool, int16_t * const, int16_t * const);
+
+/// Upper bound on the size of any statechart context, in bytes
+#define STATECHART_CONTEXT_MAX_SIZE		256
+
+/// Copy the internal state of the statechart, so that a host can carry it
+/// over to a rebuilt statechart without restarting.
+/// \returns size of the context, in bytes, or 0 if the buffer is too small
+size_t irobotNavigationStatechartContextSave(
+	void * const				pContext,			///< [out] context
+	const size_t				contextSize			///< [in] size of pContext, in bytes
+);
+
+/// Restore the internal state of the statechart from a saved context.
+/// \returns true if the context was saved by the same statechart and layout;
+/// otherwise the statechart is left unchanged
+bool irobotNavigationStatechartContextRestore(
+	const void * const			pContext,			///< [in] context
+	const size_t				contextSize			///< [in] size of the context, in bytes
+);
+
+/// Pointers to the context functions
+typedef size_t (*irobotNavigationStatechartContextSave_t)(void * const, const size_t);
+typedef bool (*irobotNavigationStatechartContextRestore_t)(const void * const, const size_t);
+
+/// What ends a maneuver
+typedef enum{
+	MANEUVER_NONE = 0,					///< not a maneuver; e.g. driving until the next obstacle
+	MANEUVER_DISTANCE,					///< ends when the net distance reaches the target
+	MANEUVER_ANGLE						///< ends when the net angle reaches the target
+} irobotManeuverEnd_t;
+
+/// Maneuver in progress: the wheel speeds of the last execution, held until a target
+typedef struct{
+	irobotManeuverEnd_t	end;			///< what ends the maneuver
+	int32_t				target;			///< net distance, in mm, or net angle, in deg, at which the maneuver ends
+} irobotManeuver_t;
+
+/// Describe the maneuver the last execution of the statechart started or
+/// continued, so that a host can hand it to the iRobot as a script.
+/// \returns false if the wheel speeds are not held until a distance or angle
+bool irobotNavigationStatechartManeuver(
+	irobotManeuver_t * const	pManeuver			///< [out] maneuver
+);
+
+/// Pointer to the maneuver function
+typedef bool (*irobotNavigationStatechartManeuver_t)(irobotManeuver_t * const);
+
 #endif // IROBOTNAVIGATIONSTATECHART_H_
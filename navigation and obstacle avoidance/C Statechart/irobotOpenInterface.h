@@ -0,0 +1,47 @@
+/** \file irobotOpenInterface.h
+ *
+ * iRobot Create Open Interface: the opcodes and robot dimensions shared by
+ * the code that plans commands for the iRobot and by the stand-in that
+ * plays the iRobot, so that the two cannot disagree.
+ */
+
+#ifndef IROBOTOPENINTERFACE_H_
+#define IROBOTOPENINTERFACE_H_
+
+/// Open Interface opcodes
+typedef enum{
+	OI_START = 128,
+	OI_BAUD,
+	OI_CONTROL,
+	OI_SAFE,
+	OI_FULL,
+	OI_SPOT = 134,
+	OI_COVER,
+	OI_DEMO,
+	OI_DRIVE,
+	OI_LOW_SIDE_DRIVERS,
+	OI_LEDS,
+	OI_SONG,
+	OI_PLAY,
+	OI_SENSORS,
+	OI_COVER_AND_DOCK,
+	OI_PWM_LOW_SIDE_DRIVERS,
+	OI_DRIVE_DIRECT,
+	OI_DIGITAL_OUTPUTS = 147,
+	OI_STREAM,
+	OI_QUERY_LIST,
+	OI_PAUSE_RESUME_STREAM,
+	OI_SEND_IR,
+	OI_SCRIPT,
+	OI_PLAY_SCRIPT,
+	OI_SHOW_SCRIPT,
+	OI_WAIT_TIME,
+	OI_WAIT_DISTANCE,
+	OI_WAIT_ANGLE,
+	OI_WAIT_EVENT
+} irobotOpenInterfaceOpcode_t;
+
+#define OI_SCRIPT_MAX_SIZE		100			///< longest script, in bytes
+#define OI_WHEEL_BASE			258.0		///< distance between the wheels of the Create, in mm
+
+#endif // IROBOTOPENINTERFACE_H_
@@ -0,0 +1,118 @@
+/** \file irobotScript.c
+ *
+ * Script stage between the statechart and the iRobot.
+ */
+
+#define _USE_MATH_DEFINES
+#include "irobotScript.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEG_PER_RAD				(180.0 / M_PI)
+
+// framing of the script commands
+#define SCRIPT_UPLOAD_OVERHEAD	2			// Script opcode and length, in bytes
+#define SCRIPT_PLAY_SIZE		1			// Play Script, in bytes
+
+/// Hand the maneuver back to tick by tick control.
+static uint32_t scriptFallBack(irobotScript_t * const pScript){
+	if(pScript->scripting){
+		pScript->nFallbacks++;
+		pScript->scripting = false;
+	}
+	return 0;
+}
+
+void irobotScriptInit(irobotScript_t * const pScript, const uint32_t segmentMs){
+	memset(pScript, 0, sizeof(*pScript));
+	pScript->segmentMs = segmentMs;
+}
+
+uint32_t irobotScriptPlan(
+	irobotScript_t * const				pScript,
+	const irobotManeuver_t * const		pManeuver,
+	const int32_t						netDistance,
+	const int32_t						netAngle,
+	const irobotSensorGroup6_t * const	pSensors,
+	const int16_t						leftWheelSpeed,
+	const int16_t						rightWheelSpeed,
+	bool * const						pUpload,
+	bool * const						pStop
+){
+	uint8_t		script[OI_SCRIPT_MAX_SIZE];
+	uint8_t		size = 0;
+	int64_t		remaining;		// distance, in mm, or angle, in deg, to the end of the maneuver
+	double		rate;			// speed, in mm/s, or turn rate, in deg/s, toward the end
+	double		step;			// distance or angle of a segment
+	int32_t		wait;			// distance or angle the script waits for
+
+	*pUpload = false;
+	*pStop = false;
+
+	// obstacles are for the statechart to react to, at every tick
+	if(   !pManeuver
+	   || pManeuver->end == MANEUVER_NONE
+	   || pScript->segmentMs == 0
+	   || pSensors->bumps_wheelDrops.bumpLeft
+	   || pSensors->bumps_wheelDrops.bumpRight
+	   || pSensors->bumps_wheelDrops.wheeldropLeft
+	   || pSensors->bumps_wheelDrops.wheeldropRight
+	   || pSensors->cliffLeft
+	   || pSensors->cliffFrontLeft
+	   || pSensors->cliffFrontRight
+	   || pSensors->cliffRight
+	){
+		return scriptFallBack(pScript);
+	}
+
+	if(pManeuver->end == MANEUVER_DISTANCE){
+		remaining = (int64_t)pManeuver->target - netDistance;
+		rate = (leftWheelSpeed + rightWheelSpeed) / 2.0;
+		script[size++] = OI_WAIT_DISTANCE;
+	}
+	else{
+		remaining = (int64_t)pManeuver->target - netAngle;
+		rate = (rightWheelSpeed - leftWheelSpeed) / OI_WHEEL_BASE * DEG_PER_RAD;
+		script[size++] = OI_WAIT_ANGLE;
+	}
+
+	// the iRobot would wait forever for a target it is not moving toward
+	if(remaining == 0 || rate == 0 || (remaining > 0) != (rate > 0)){
+		return scriptFallBack(pScript);
+	}
+
+	// whole steps, the last of which takes up the remainder; waits are 16 bit
+	step = fmin(fmax(floor(fabs(rate) * pScript->segmentMs / 1000), 1), INT16_MAX);
+	if(llabs(remaining) > 1.5 * step){
+		wait = (int32_t)(remaining > 0 ? step : -step);
+	}
+	else{
+		wait = (int32_t)remaining;
+		*pStop = true;
+	}
+	script[size++] = (uint8_t)((uint16_t)wait >> 8);
+	script[size++] = (uint8_t)wait;
+	if(*pStop){
+		script[size++] = OI_DRIVE_DIRECT;
+		script[size++] = 0;
+		script[size++] = 0;
+		script[size++] = 0;
+		script[size++] = 0;
+	}
+
+	// a maneuver repeats the same step, so the script is usually on the iRobot already
+	if(!pScript->uploaded || size != pScript->scriptSize || memcmp(script, pScript->script, size) != 0){
+		memcpy(pScript->script, script, size);
+		pScript->scriptSize = size;
+		pScript->uploaded = true;
+		pScript->nUploads++;
+		pScript->bytesSent += SCRIPT_UPLOAD_OVERHEAD + size;
+		*pUpload = true;
+	}
+	pScript->nSegments++;
+	pScript->bytesSent += SCRIPT_PLAY_SIZE;
+	pScript->scripting = !*pStop;
+
+	return (uint32_t)ceil(1000 * abs(wait) / fabs(rate));
+}
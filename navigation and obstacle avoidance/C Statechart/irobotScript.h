@@ -0,0 +1,66 @@
+/** \file irobotScript.h
+ *
+ * Script stage between the statechart and the iRobot: runs maneuvers that
+ * end at a known distance or angle as Open Interface scripts, so that the
+ * iRobot ends them on its own odometry instead of at the next tick of the
+ * control loop, and the loop need not poll the sensors at the maneuver
+ * period meanwhile.
+ *
+ * While a script waits for a distance or angle, the iRobot does not react
+ * to serial input; a sensor query is answered only once the wait is over.
+ * A maneuver is therefore cut into segments of about segmentMs. Each
+ * segment plays the uploaded script, which waits for one step of the
+ * maneuver, and the loop reads the sensors between segments. The wheels
+ * keep their speeds from one segment to the next; the last segment waits
+ * for the rest of the maneuver and stops them. A bump, cliff or wheel drop
+ * hands the maneuver back to tick by tick control, as does anything the
+ * stage cannot script, such as wheel speeds still being limited by the
+ * actuation stage.
+ */
+
+#ifndef IROBOTSCRIPT_H_
+#define IROBOTSCRIPT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "irobotNavigationStatechart.h"
+#include "irobotOpenInterface.h"
+#include "irobotSensorTypes.h"
+
+/// Script stage state
+typedef struct{
+	uint32_t	segmentMs;					///< duration of a segment, in ms
+	uint8_t		script[OI_SCRIPT_MAX_SIZE];	///< script of the last segment planned
+	uint8_t		scriptSize;					///< size of the script, in bytes
+	bool		uploaded;					///< the script is on the iRobot
+	bool		scripting;					///< the last segment played left the maneuver unfinished
+	uint32_t	nSegments;					///< number of segments played
+	uint32_t	nUploads;					///< number of scripts uploaded
+	uint32_t	nFallbacks;					///< maneuvers handed back to tick by tick control before they ended
+	uint64_t	bytesSent;					///< bytes of script uploads and play commands
+} irobotScript_t;
+
+/// Initialize the script stage. No script is on the iRobot.
+void irobotScriptInit(
+	irobotScript_t * const				pScript,			///< [out] script stage
+	const uint32_t						segmentMs			///< [in] duration of a segment, in ms
+);
+
+/// Plan the next segment of the maneuver the statechart is executing. To
+/// run it, upload pScript->script if *pUpload, play it, and read the
+/// sensors no earlier than the returned time.
+/// \returns expected duration of the segment, in ms, or 0 if the wheel
+/// speeds must be commanded tick by tick
+uint32_t irobotScriptPlan(
+	irobotScript_t * const				pScript,			///< [in,out] script stage
+	const irobotManeuver_t * const		pManeuver,			///< [in] maneuver in progress, or NULL
+	const int32_t						netDistance,		///< [in] net distance, in mm
+	const int32_t						netAngle,			///< [in] net angle, in deg
+	const irobotSensorGroup6_t * const	pSensors,			///< [in] sensors read this tick
+	const int16_t						leftWheelSpeed,		///< [in] left wheel speed, in mm/s, commanded and requested for the maneuver
+	const int16_t						rightWheelSpeed,	///< [in] right wheel speed, in mm/s, commanded and requested for the maneuver
+	bool * const						pUpload,			///< [out] the script differs from the one on the iRobot
+	bool * const						pStop				///< [out] the segment ends the maneuver and stops the wheels
+);
+
+#endif // IROBOTSCRIPT_H_
@@ -0,0 +1,115 @@
+/** \file irobotSharedMap.c
+ *
+ * Map layout, and the translation of sensor events into cells around the
+ * robot.
+ */
+
+#include "irobotSharedMap.h"
+#include <math.h>
+
+#define ROBOT_RADIUS		170.0		// radius of the robot, in mm
+#define WALL_SENSOR_RANGE	50.0		// range of the wall sensor beyond the robot, in mm
+
+/// Sensor event, at a bearing from the robot heading
+typedef struct{
+	double		bearing;				// counter-clockwise from the heading, in rad
+	double		range;					// distance from the robot center, in mm
+	uint8_t		flag;					// flag marked when the event occurs
+} mapEvent_t;
+
+// bumpers, wall sensor and cliff sensors of the Create
+enum{ EVENT_BUMP_LEFT, EVENT_BUMP_RIGHT, EVENT_WALL, EVENT_CLIFF_LEFT, EVENT_CLIFF_FRONT_LEFT, EVENT_CLIFF_FRONT_RIGHT, EVENT_CLIFF_RIGHT, EVENTS };
+static const mapEvent_t events[EVENTS] = {
+	[EVENT_BUMP_LEFT] =			{ M_PI / 4,		ROBOT_RADIUS,						SHARED_MAP_OBSTACLE},
+	[EVENT_BUMP_RIGHT] =		{-M_PI / 4,		ROBOT_RADIUS,						SHARED_MAP_OBSTACLE},
+	[EVENT_WALL] =				{-M_PI / 2,		ROBOT_RADIUS + WALL_SENSOR_RANGE,	SHARED_MAP_WALL},
+	[EVENT_CLIFF_LEFT] =		{ M_PI / 3,		ROBOT_RADIUS,						SHARED_MAP_CLIFF},
+	[EVENT_CLIFF_FRONT_LEFT] =	{ M_PI / 12,	ROBOT_RADIUS,						SHARED_MAP_CLIFF},
+	[EVENT_CLIFF_FRONT_RIGHT] =	{-M_PI / 12,	ROBOT_RADIUS,						SHARED_MAP_CLIFF},
+	[EVENT_CLIFF_RIGHT] =		{-M_PI / 3,		ROBOT_RADIUS,						SHARED_MAP_CLIFF},
+};
+
+/// \returns cells per side of a room, rounded up to whole tiles
+static uint32_t mapCellsPerSide(const double roomSize, const double cellSize){
+	const uint32_t cells = (uint32_t)ceil(roomSize / cellSize);
+
+	return (cells + SHARED_MAP_TILE_SIDE - 1) / SHARED_MAP_TILE_SIDE * SHARED_MAP_TILE_SIDE;
+}
+
+size_t irobotSharedMapSize(const double roomSize, const double cellSize){
+	const size_t cellsPerSide = mapCellsPerSide(roomSize, cellSize);
+
+	return sizeof(irobotSharedMap_t) + cellsPerSide * cellsPerSide;
+}
+
+irobotSharedMap_t * irobotSharedMapInit(void * const pMemory, const double roomSize, const double cellSize){
+	irobotSharedMap_t * const	pMap = (irobotSharedMap_t*)pMemory;
+	const uint32_t				cellsPerSide = mapCellsPerSide(roomSize, cellSize);
+	size_t						i;
+
+	pMap->cellsPerSide = cellsPerSide;
+	pMap->tilesPerSide = cellsPerSide / SHARED_MAP_TILE_SIDE;
+	pMap->cellsPerMm = 1 / cellSize;
+	pMap->originX = -(cellsPerSide * cellSize) / 2;
+	pMap->originY = -(cellsPerSide * cellSize) / 2;
+	for(i = 0; i < (size_t)cellsPerSide * cellsPerSide; i++){
+		atomic_init(&pMap->cells[i], 0);
+	}
+	return pMap;
+}
+
+/// Mark the cell of an event.
+static bool mapMarkEvent(irobotSharedMap_t * const pMap, const double x, const double y, const double heading, const mapEvent_t * const pEvent){
+	return irobotSharedMapMark(pMap,
+							   x + pEvent->range * cos(heading + pEvent->bearing),
+							   y + pEvent->range * sin(heading + pEvent->bearing),
+							   pEvent->flag);
+}
+
+uint32_t irobotSharedMapRecord(
+	irobotSharedMap_t * const			pMap,
+	const double						x,
+	const double						y,
+	const double						heading,
+	const irobotSensorGroup6_t * const	pSensors
+){
+	uint32_t nMarked = 0;
+
+	// the robot is standing on its cell, so whatever was bumped there has moved
+	irobotSharedMapClear(pMap, x, y, SHARED_MAP_OBSTACLE);
+	nMarked += irobotSharedMapMark(pMap, x, y, SHARED_MAP_VISITED);
+
+	if(pSensors->bumps_wheelDrops.bumpLeft){
+		nMarked += mapMarkEvent(pMap, x, y, heading, &events[EVENT_BUMP_LEFT]);
+	}
+	if(pSensors->bumps_wheelDrops.bumpRight){
+		nMarked += mapMarkEvent(pMap, x, y, heading, &events[EVENT_BUMP_RIGHT]);
+	}
+	if(pSensors->wall){
+		nMarked += mapMarkEvent(pMap, x, y, heading, &events[EVENT_WALL]);
+	}
+	if(pSensors->cliffLeft){
+		nMarked += mapMarkEvent(pMap, x, y, heading, &events[EVENT_CLIFF_LEFT]);
+	}
+	if(pSensors->cliffFrontLeft){
+		nMarked += mapMarkEvent(pMap, x, y, heading, &events[EVENT_CLIFF_FRONT_LEFT]);
+	}
+	if(pSensors->cliffFrontRight){
+		nMarked += mapMarkEvent(pMap, x, y, heading, &events[EVENT_CLIFF_FRONT_RIGHT]);
+	}
+	if(pSensors->cliffRight){
+		nMarked += mapMarkEvent(pMap, x, y, heading, &events[EVENT_CLIFF_RIGHT]);
+	}
+	return nMarked;
+}
+
+uint32_t irobotSharedMapCount(const irobotSharedMap_t * const pMap, const uint8_t flags){
+	const size_t	nCells = (size_t)pMap->cellsPerSide * pMap->cellsPerSide;
+	uint32_t		count = 0;
+	size_t			i;
+
+	for(i = 0; i < nCells; i++){
+		count += (atomic_load_explicit((_Atomic uint8_t *)&pMap->cells[i], memory_order_relaxed) & flags) == flags;
+	}
+	return count;
+}
@@ -0,0 +1,128 @@
+/** \file irobotSharedMap.h
+ *
+ * Occupancy map shared by many simulated robots exploring the same room.
+ * Each cell holds event flags: visited, obstacle (bumper), wall (wall
+ * sensor) and cliff (cliff sensors). Robots in different threads, or in
+ * different processes when the map is in MAP_SHARED memory, mark and read
+ * cells concurrently without locks.
+ *
+ * A cell is one lock-free atomic byte. Cells are stored in 8 x 8 tiles of
+ * one cache line each, so that robots in different parts of the room do
+ * not share lines. Marking first loads the cell and only performs the
+ * atomic OR when a flag is missing; once a region has been explored, its
+ * lines stay shared in every core's cache instead of bouncing between
+ * writers. Flags are independent, so relaxed ordering is sufficient.
+ *
+ * The map is one block of memory with no pointers, sized with
+ * irobotSharedMapSize() and initialized in place with irobotSharedMapInit().
+ */
+
+#ifndef IROBOTSHAREDMAP_H_
+#define IROBOTSHAREDMAP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "irobotSensorTypes.h"
+
+#define SHARED_MAP_TILE_SIDE		8		///< cells per side of a tile
+#define SHARED_MAP_TILE_CELLS		(SHARED_MAP_TILE_SIDE * SHARED_MAP_TILE_SIDE)	///< cells per tile; one cache line
+
+// cell flags
+#define SHARED_MAP_VISITED			0x01	///< a robot has driven over the cell
+#define SHARED_MAP_OBSTACLE			0x02	///< a bumper was pressed against the cell
+#define SHARED_MAP_WALL				0x04	///< the wall sensor saw the cell
+#define SHARED_MAP_CLIFF			0x08	///< a cliff sensor saw the cell
+
+/// Shared map
+typedef struct{
+	double					originX;		///< x of the map corner with the smallest coordinates, in mm
+	double					originY;		///< y of the map corner with the smallest coordinates, in mm
+	double					cellsPerMm;		///< inverse of the cell size
+	uint32_t				cellsPerSide;	///< cells per side of the map; a multiple of the tile side
+	uint32_t				tilesPerSide;	///< tiles per side of the map
+	_Alignas(64) _Atomic uint8_t	cells[];	///< cells, tile by tile, each tile row by row
+} irobotSharedMap_t;
+
+/// \returns bytes needed for a map of a square room
+size_t irobotSharedMapSize(
+	const double					roomSize,		///< [in] side of the room, in mm
+	const double					cellSize		///< [in] side of a cell, in mm
+);
+
+/// Initialize an empty map of a square room centered on the origin, in
+/// memory of irobotSharedMapSize() bytes aligned to 64 bytes, such as a
+/// shared mapping.
+/// \returns map, at the start of the memory
+irobotSharedMap_t * irobotSharedMapInit(
+	void * const					pMemory,		///< [out] memory for the map
+	const double					roomSize,		///< [in] side of the room, in mm
+	const double					cellSize		///< [in] side of a cell, in mm
+);
+
+/// Record the sensor events of one tick, for a robot at a known pose.
+/// \returns number of cells that gained a flag
+uint32_t irobotSharedMapRecord(
+	irobotSharedMap_t * const			pMap,		///< [in,out] map
+	const double						x,			///< [in] robot position, in mm
+	const double						y,			///< [in] robot position, in mm
+	const double						heading,	///< [in] robot heading, counter-clockwise from +x, in rad
+	const irobotSensorGroup6_t * const	pSensors	///< [in] sensors read this tick
+);
+
+/// Count the cells that have every one of some flags.
+uint32_t irobotSharedMapCount(
+	const irobotSharedMap_t * const		pMap,		///< [in] map
+	const uint8_t						flags		///< [in] flags
+);
+
+/// \returns cell at a position, or NULL outside the map
+static inline _Atomic uint8_t * irobotSharedMapCell(const irobotSharedMap_t * const pMap, const double x, const double y){
+	const double	column = (x - pMap->originX) * pMap->cellsPerMm;
+	const double	row = (y - pMap->originY) * pMap->cellsPerMm;
+	uint32_t		c;
+	uint32_t		r;
+
+	if(!(column >= 0 && row >= 0 && column < pMap->cellsPerSide && row < pMap->cellsPerSide)){
+		return NULL;
+	}
+	c = (uint32_t)column;
+	r = (uint32_t)row;
+	return (_Atomic uint8_t *)&pMap->cells[
+		((r / SHARED_MAP_TILE_SIDE) * pMap->tilesPerSide + c / SHARED_MAP_TILE_SIDE) * SHARED_MAP_TILE_CELLS
+		+ (r % SHARED_MAP_TILE_SIDE) * SHARED_MAP_TILE_SIDE + c % SHARED_MAP_TILE_SIDE];
+}
+
+/// Set flags on the cell at a position; outside the map, nothing is set.
+/// \returns true if this call set a flag the cell did not have
+static inline bool irobotSharedMapMark(irobotSharedMap_t * const pMap, const double x, const double y, const uint8_t flags){
+	_Atomic uint8_t * const pCell = irobotSharedMapCell(pMap, x, y);
+
+	// the load keeps the line shared when the flags are already set
+	if(!pCell || (atomic_load_explicit(pCell, memory_order_relaxed) & flags) == flags){
+		return false;
+	}
+	return (atomic_fetch_or_explicit(pCell, flags, memory_order_relaxed) & flags) != flags;
+}
+
+/// Clear flags on the cell at a position, e.g. an obstacle that was
+/// another robot and has moved; outside the map, nothing is cleared.
+/// \returns true if this call cleared a flag the cell had
+static inline bool irobotSharedMapClear(irobotSharedMap_t * const pMap, const double x, const double y, const uint8_t flags){
+	_Atomic uint8_t * const pCell = irobotSharedMapCell(pMap, x, y);
+
+	if(!pCell || (atomic_load_explicit(pCell, memory_order_relaxed) & flags) == 0){
+		return false;
+	}
+	return (atomic_fetch_and_explicit(pCell, (uint8_t)~flags, memory_order_relaxed) & flags) != 0;
+}
+
+/// \returns flags of the cell at a position; 0 outside the map
+static inline uint8_t irobotSharedMapRead(const irobotSharedMap_t * const pMap, const double x, const double y){
+	_Atomic uint8_t * const pCell = irobotSharedMapCell(pMap, x, y);
+
+	return pCell ? atomic_load_explicit(pCell, memory_order_relaxed) : 0;
+}
+
+#endif // IROBOTSHAREDMAP_H_
@@ -0,0 +1,195 @@
+/** \file irobotStatechartCoverage.c
+ *
+ * Registry of the per-thread transition counters, merged and written at
+ * exit. Counter blocks are never freed, so the counts of threads that have
+ * already exited, and of statechart libraries that have been unloaded, are
+ * included. Nothing in the registry points into a statechart: a library
+ * may be unloaded before the host exits.
+ */
+
+#include "irobotStatechartCoverage.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(_WIN32)
+	#include <windows.h>
+	static SRWLOCK				lock = SRWLOCK_INIT;
+	#define coverageLock()		AcquireSRWLockExclusive(&lock)
+	#define coverageUnlock()	ReleaseSRWLockExclusive(&lock)
+#else
+	#include <pthread.h>
+	static pthread_mutex_t		lock = PTHREAD_MUTEX_INITIALIZER;
+	#define coverageLock()		pthread_mutex_lock(&lock)
+	#define coverageUnlock()	pthread_mutex_unlock(&lock)
+#endif
+
+static const char * const defaultPath = "statechart_coverage.csv";	// output when STATECHART_COVERAGE_FILE is not set
+
+/// Registered statechart; a copy of its description
+typedef struct coverageChart_s{
+	statechartCoverage_t			description;	// name and states, owned by the registry
+	struct coverageChart_s *		next;			// next statechart
+} coverageChart_t;
+
+/// Counters of one thread for one statechart
+typedef struct counterBlock_s{
+	const coverageChart_t *			pChart;			// statechart counted
+	uint64_t *						counters;		// transition counters, [from][to]
+	struct counterBlock_s *			next;			// next block
+} counterBlock_t;
+
+// registry; guarded by lock
+static coverageChart_t *		charts = NULL;		// statecharts with counters
+static counterBlock_t *			blocks = NULL;		// every thread's counters
+static bool						exitRegistered = false;
+
+/// \returns copy of a string, or NULL if out of memory
+static char * coverageCopyString(const char * const string){
+	char * const copy = malloc(strlen(string) + 1);
+
+	if(copy){
+		strcpy(copy, string);
+	}
+	return copy;
+}
+
+/// \returns true if a registered statechart has the given name and states
+static bool coverageSameChart(const statechartCoverage_t * const pRegistered, const statechartCoverage_t * const pCoverage){
+	uint32_t i;
+
+	if(pRegistered->nStates != pCoverage->nStates || strcmp(pRegistered->name, pCoverage->name) != 0){
+		return false;
+	}
+	for(i = 0; i < pCoverage->nStates; i++){
+		if(strcmp(pRegistered->stateNames[i], pCoverage->stateNames[i]) != 0){
+			return false;
+		}
+	}
+	return true;
+}
+
+/// Copy a statechart description into the registry. Nothing is freed on
+/// failure, since the caller aborts.
+/// \returns registered statechart, or NULL if out of memory
+static coverageChart_t * coverageRegister(const statechartCoverage_t * const pCoverage){
+	coverageChart_t * const	pChart = calloc(1, sizeof(*pChart));
+	const char ** const		stateNames = calloc(pCoverage->nStates, sizeof(*stateNames));
+	bool					copied;
+	uint32_t				i;
+
+	if(!pChart || !stateNames){
+		return NULL;
+	}
+	pChart->description.name = coverageCopyString(pCoverage->name);
+	pChart->description.stateNames = stateNames;
+	pChart->description.nStates = pCoverage->nStates;
+	copied = pChart->description.name != NULL;
+	for(i = 0; i < pCoverage->nStates; i++){
+		stateNames[i] = coverageCopyString(pCoverage->stateNames[i]);
+		copied = copied && stateNames[i];
+	}
+	return copied ? pChart : NULL;
+}
+
+/// Write the coverage file at exit.
+static void coverageAtExit(void){
+	const char *	path = getenv("STATECHART_COVERAGE_FILE");
+	FILE *			file;
+
+	file = fopen(path ? path : defaultPath, "w");
+	if(!file){
+		perror("statechart coverage: fopen");
+		return;
+	}
+	irobotStatechartCoverageWrite(file);
+	fclose(file);
+}
+
+uint64_t * irobotStatechartCoverageAttach(const statechartCoverage_t * const pCoverage){
+	counterBlock_t * const	pBlock = malloc(sizeof(*pBlock));
+	uint64_t * const		counters = calloc((size_t)pCoverage->nStates * pCoverage->nStates, sizeof(*counters));
+	coverageChart_t *		pChart;
+
+	coverageLock();
+	for(pChart = charts; pChart && !coverageSameChart(&pChart->description, pCoverage); pChart = pChart->next){
+	}
+	if(!pChart && pBlock && counters){
+		pChart = coverageRegister(pCoverage);
+		if(pChart){
+			pChart->next = charts;
+			charts = pChart;
+		}
+	}
+	if(!pBlock || !counters || !pChart){
+		// the statechart has no way to report an error
+		coverageUnlock();
+		fprintf(stderr, "statechart coverage: out of memory\n");
+		abort();
+	}
+
+	pBlock->pChart = pChart;
+	pBlock->counters = counters;
+	pBlock->next = blocks;
+	blocks = pBlock;
+	if(!exitRegistered){
+		exitRegistered = true;
+		atexit(coverageAtExit);
+	}
+	coverageUnlock();
+
+	return counters;
+}
+
+void irobotStatechartCoverageWrite(FILE * const file){
+	const coverageChart_t *			pRegistered;
+	const counterBlock_t *			pBlock;
+
+	coverageLock();
+	for(pRegistered = charts; pRegistered; pRegistered = pRegistered->next){
+		const statechartCoverage_t * const	pChart = &pRegistered->description;
+		const uint32_t						n = pChart->nStates;
+		uint64_t *							merged = calloc((size_t)n * n, sizeof(*merged));
+		uint32_t							from;
+		uint32_t							to;
+		uint32_t							i;
+
+		if(!merged){
+			break;
+		}
+		for(pBlock = blocks; pBlock; pBlock = pBlock->next){
+			if(pBlock->pChart == pRegistered){
+				for(i = 0; i < n * n; i++){
+					merged[i] += pBlock->counters[i];
+				}
+			}
+		}
+
+		// rows are the state at the start of a tick, columns the state after it
+		fprintf(file, "statechart,%s\nfrom\\to", pChart->name);
+		for(to = 0; to < n; to++){
+			fprintf(file, ",%s", pChart->stateNames[to]);
+		}
+		fprintf(file, "\n");
+		for(from = 0; from < n; from++){
+			fprintf(file, "%s", pChart->stateNames[from]);
+			for(to = 0; to < n; to++){
+				fprintf(file, ",%llu", (unsigned long long)merged[from * n + to]);
+			}
+			fprintf(file, "\n");
+		}
+
+		// ticks whose actions ran in each state
+		fprintf(file, "ticks");
+		for(to = 0; to < n; to++){
+			uint64_t ticks = 0;
+			for(from = 0; from < n; from++){
+				ticks += merged[from * n + to];
+			}
+			fprintf(file, ",%llu", (unsigned long long)ticks);
+		}
+		fprintf(file, "\n\n");
+		free(merged);
+	}
+	coverageUnlock();
+}
@@ -0,0 +1,94 @@
+/** \file irobotStatechartCoverage.h
+ *
+ * Optional transition coverage for the statecharts. Build with
+ * STATECHART_COVERAGE defined to count, for every statechart, how often
+ * each (from-state, to-state) transition is taken, where a tick that
+ * stays in its state counts as the transition to itself. Counters are
+ * per thread, so a tick costs one thread-local increment; they are merged
+ * when the process exits and written as one matrix per statechart to the
+ * CSV file named by the STATECHART_COVERAGE_FILE environment variable, or
+ * statechart_coverage.csv.
+ *
+ * Without STATECHART_COVERAGE the macros expand to nothing.
+ *
+ * The registry and the writer live in the program that links
+ * irobotStatechartCoverage.c. A statechart library loaded at runtime
+ * (target/plugin) does not link it; its counters attach to the registry of
+ * the host, which must export it (-rdynamic), and outlive the library, so
+ * that every generation of a reloaded library is merged into one file
+ * written when the host exits.
+ *
+ * A statechart defines its coverage once, at file scope,
+ *
+ *	STATECHART_COVERAGE_DEFINE("irobotNavStatechart", stateNames);
+ *
+ * and brackets the transitions of each tick,
+ *
+ *	STATECHART_COVERAGE_FROM(state);
+ *	... state transitions ...
+ *	STATECHART_COVERAGE_TO(state);
+ */
+
+#ifndef IROBOTSTATECHARTCOVERAGE_H_
+#define IROBOTSTATECHARTCOVERAGE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+/// Statechart being covered
+typedef struct{
+	const char *					name;			///< name of the statechart
+	const char * const *			stateNames;		///< name of each state, indexed by state
+	uint32_t						nStates;		///< number of states
+} statechartCoverage_t;
+
+/// Allocate and register the calling thread's counters for a statechart.
+/// Statecharts with the same name and states share one matrix; the
+/// registry keeps its own copy of the names.
+/// \returns nStates x nStates transition counters, indexed [from][to]
+uint64_t * irobotStatechartCoverageAttach(
+	const statechartCoverage_t * const	pCoverage	///< [in] statechart
+);
+
+/// Write the merged counters of every statechart as CSV, one matrix each.
+void irobotStatechartCoverageWrite(
+	FILE * const					file			///< [in] output
+);
+
+#ifdef STATECHART_COVERAGE
+
+#if defined(_MSC_VER)
+	#define STATECHART_THREAD_LOCAL		__declspec(thread)
+#else
+	#define STATECHART_THREAD_LOCAL		__thread
+#endif
+
+/// Define the coverage of the statechart in this file.
+#define STATECHART_COVERAGE_DEFINE(chartName, names)								\
+	enum{ coverageStates = sizeof(names) / sizeof((names)[0]) };					\
+	static const statechartCoverage_t coverage = {chartName, names, coverageStates};	\
+	static STATECHART_THREAD_LOCAL uint64_t * coverageCounters = NULL
+
+/// Record the state at the start of a tick.
+#define STATECHART_COVERAGE_FROM(fromState)											\
+	const uint32_t coverageFrom = (uint32_t)(fromState)
+
+/// Count the transition taken by this tick.
+#define STATECHART_COVERAGE_TO(toState)												\
+	do{																				\
+		if(!coverageCounters){														\
+			coverageCounters = irobotStatechartCoverageAttach(&coverage);			\
+		}																			\
+		coverageCounters[coverageFrom * coverageStates + (uint32_t)(toState)]++;		\
+	}while(0)
+
+#else
+
+#define STATECHART_COVERAGE_DEFINE(chartName, names)	\
+	typedef char statechartCoverageNames_t[sizeof(names)]
+#define STATECHART_COVERAGE_FROM(fromState)		((void)0)
+#define STATECHART_COVERAGE_TO(toState)			((void)0)
+
+#endif // STATECHART_COVERAGE
+
+#endif // IROBOTSTATECHARTCOVERAGE_H_
@@ -0,0 +1,85 @@
+/** \file irobotStatechartVariants.c
+ *
+ * Variant table, and the irobotNavigationStatechart() functions that
+ * forward to the selected variant.
+ */
+
+#include "irobotStatechartVariants.h"
+#include <string.h>
+
+#ifndef IROBOT_STATECHART_VARIANTS
+	#error "irobotStatechartVariants.c and the variants must be built with IROBOT_STATECHART_VARIANTS defined"
+#endif
+
+/// Declare the functions of one variant.
+#define VARIANT_DECLARE(variant)																\
+	uint32_t variant(const int32_t, const int32_t, const irobotSensorGroup6_t,					\
+		const accelerometer_t, const bool, int16_t * const, int16_t * const);					\
+	size_t variant##ContextSave(void * const, const size_t);									\
+	bool variant##ContextRestore(const void * const, const size_t);								\
+	bool variant##Maneuver(irobotManeuver_t * const)
+
+/// Variant table entry.
+#define VARIANT_ENTRY(variant)		{#variant, variant, variant##ContextSave, variant##ContextRestore, variant##Maneuver}
+
+VARIANT_DECLARE(irobotNavStatechart);
+VARIANT_DECLARE(irobotHillClimbStatechart);
+VARIANT_DECLARE(irobotWaypointStatechart);
+VARIANT_DECLARE(irobotNavTableStatechart);
+
+const irobotStatechartVariant_t irobotStatechartVariants[] = {
+	VARIANT_ENTRY(irobotNavStatechart),
+	VARIANT_ENTRY(irobotHillClimbStatechart),
+	VARIANT_ENTRY(irobotWaypointStatechart),
+	VARIANT_ENTRY(irobotNavTableStatechart),
+};
+
+const size_t irobotStatechartVariantCount = sizeof(irobotStatechartVariants) / sizeof(irobotStatechartVariants[0]);
+
+// variant that irobotNavigationStatechart() forwards to
+static const irobotStatechartVariant_t * pSelected = &irobotStatechartVariants[0];
+
+const irobotStatechartVariant_t * irobotStatechartVariantFind(const char * const name){
+	size_t i;
+
+	for(i = 0; name && i < irobotStatechartVariantCount; i++){
+		if(strcmp(irobotStatechartVariants[i].name, name) == 0){
+			return &irobotStatechartVariants[i];
+		}
+	}
+	return NULL;
+}
+
+bool irobotNavigationStatechartSelect(const char * const name){
+	const irobotStatechartVariant_t * const pVariant = irobotStatechartVariantFind(name);
+
+	if(!pVariant){
+		return false;
+	}
+	pSelected = pVariant;
+	return true;
+}
+
+uint32_t irobotNavigationStatechart(
+	const int32_t 				netDistance,
+	const int32_t 				netAngle,
+	const irobotSensorGroup6_t	sensors,
+	const accelerometer_t		accelAxes,
+	const bool					isSimulator,
+	int16_t * const 			pRightWheelSpeed,
+	int16_t * const 			pLeftWheelSpeed
+){
+	return pSelected->statechart(netDistance, netAngle, sensors, accelAxes, isSimulator, pRightWheelSpeed, pLeftWheelSpeed);
+}
+
+size_t irobotNavigationStatechartContextSave(void * const pContext, const size_t contextSize){
+	return pSelected->contextSave(pContext, contextSize);
+}
+
+bool irobotNavigationStatechartContextRestore(const void * const pContext, const size_t contextSize){
+	return pSelected->contextRestore(pContext, contextSize);
+}
+
+bool irobotNavigationStatechartManeuver(irobotManeuver_t * const pManeuver){
+	return pSelected->maneuver(pManeuver);
+}
@@ -0,0 +1,50 @@
+/** \file irobotStatechartVariants.h
+ *
+ * Every statechart variant, linked into one program. Build the variants
+ * and irobotStatechartVariants.c with IROBOT_STATECHART_VARIANTS defined:
+ *
+ *	../irobotNavStatechart.c			irobotNavStatechart
+ *	../irobotHillClimbStatechart.c		irobotHillClimbStatechart
+ *	irobotNavigationStatechart.c		irobotWaypointStatechart
+ *	../irobotNavTableStatechart.c		irobotNavTableStatechart
+ *
+ * A host looks a variant up by name and calls it through the function
+ * pointers, or selects it once and keeps calling irobotNavigationStatechart(),
+ * which then forwards to the selected variant, as do the context and
+ * maneuver functions.
+ */
+
+#ifndef IROBOTSTATECHARTVARIANTS_H_
+#define IROBOTSTATECHARTVARIANTS_H_
+
+#include "irobotNavigationStatechart.h"
+
+/// Statechart variant
+typedef struct{
+	const char *								name;				///< variant name
+	irobotNavigationStatechart_t				statechart;			///< statechart
+	irobotNavigationStatechartContextSave_t		contextSave;		///< context export
+	irobotNavigationStatechartContextRestore_t	contextRestore;		///< context import
+	irobotNavigationStatechartManeuver_t		maneuver;			///< maneuver in progress
+} irobotStatechartVariant_t;
+
+/// Variants linked into this program
+extern const irobotStatechartVariant_t	irobotStatechartVariants[];
+
+/// Number of entries in irobotStatechartVariants
+extern const size_t						irobotStatechartVariantCount;
+
+/// Find a variant by name.
+/// \returns variant, or NULL if no variant has that name
+const irobotStatechartVariant_t * irobotStatechartVariantFind(
+	const char * const			name				///< [in] variant name
+);
+
+/// Select the variant that irobotNavigationStatechart() and the context
+/// functions forward to. The first variant is selected until this is called.
+/// \returns false if no variant has that name; the selection is unchanged
+bool irobotNavigationStatechartSelect(
+	const char * const			name				///< [in] variant name
+);
+
+#endif // IROBOTSTATECHARTVARIANTS_H_
@@ -0,0 +1,101 @@
+/** \file benchmarkCounters.c
+ *
+ * Hardware performance counters for the benchmark target.
+ */
+
+#include "benchmarkCounters.h"
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+
+#ifdef __linux__
+	#include <linux/perf_event.h>
+#endif
+
+void benchmarkCountersOpen(benchmarkCounters_t * const pCounters){
+	int counter;
+
+	for(counter = 0; counter < COUNTER_COUNT; counter++){
+		pCounters->fd[counter] = -1;
+	}
+
+#ifdef __linux__
+	{
+		static const uint64_t events[COUNTER_COUNT] = {
+			PERF_COUNT_HW_CPU_CYCLES,
+			PERF_COUNT_HW_INSTRUCTIONS,
+			PERF_COUNT_HW_BRANCH_MISSES
+		};
+		struct perf_event_attr attr;
+
+		for(counter = 0; counter < COUNTER_COUNT; counter++){
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = events[counter];
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+
+			// this thread, any CPU; failure (no PMU, paranoid setting, container) leaves fd at -1
+			pCounters->fd[counter] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+		}
+	}
+#endif
+}
+
+void benchmarkCountersStart(const benchmarkCounters_t * const pCounters){
+#ifdef __linux__
+	int counter;
+
+	for(counter = 0; counter < COUNTER_COUNT; counter++){
+		if(pCounters->fd[counter] >= 0){
+			ioctl(pCounters->fd[counter], PERF_EVENT_IOC_RESET, 0);
+			ioctl(pCounters->fd[counter], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+
+void benchmarkCountersStop(const benchmarkCounters_t * const pCounters, benchmarkCounterValues_t * const pValues){
+	int counter;
+
+#ifdef __linux__
+	for(counter = 0; counter < COUNTER_COUNT; counter++){
+		if(pCounters->fd[counter] >= 0){
+			ioctl(pCounters->fd[counter], PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+#endif
+
+	for(counter = 0; counter < COUNTER_COUNT; counter++){
+		pValues->value[counter] = 0;
+		pValues->valid[counter] = pCounters->fd[counter] >= 0
+			&& read(pCounters->fd[counter], &pValues->value[counter], sizeof(uint64_t)) == sizeof(uint64_t);
+	}
+}
+
+void benchmarkCountersClose(benchmarkCounters_t * const pCounters){
+	int counter;
+
+	for(counter = 0; counter < COUNTER_COUNT; counter++){
+		if(pCounters->fd[counter] >= 0){
+			close(pCounters->fd[counter]);
+			pCounters->fd[counter] = -1;
+		}
+	}
+}
+
+const char * benchmarkCounterName(const benchmarkCounter_t counter){
+	switch(counter){
+	case COUNTER_CYCLES:
+		return "cycles";
+	case COUNTER_INSTRUCTIONS:
+		return "instructions";
+	case COUNTER_BRANCH_MISSES:
+		return "branch_misses";
+	default:
+		return "unknown";
+	}
+}
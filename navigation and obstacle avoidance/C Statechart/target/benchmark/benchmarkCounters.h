@@ -0,0 +1,59 @@
+/** \file benchmarkCounters.h
+ *
+ * Hardware performance counters for the benchmark target. Uses
+ * perf_event_open on Linux; counters that the kernel or CPU does not
+ * provide are reported as unavailable rather than failing the benchmark.
+ */
+
+#ifndef BENCHMARKCOUNTERS_H_
+#define BENCHMARKCOUNTERS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/// Hardware events counted around each benchmark run
+typedef enum{
+	COUNTER_CYCLES = 0,					///< CPU cycles
+	COUNTER_INSTRUCTIONS,				///< retired instructions
+	COUNTER_BRANCH_MISSES,				///< mispredicted branches
+	COUNTER_COUNT						///< number of counters
+} benchmarkCounter_t;
+
+/// Open counters for the calling thread
+typedef struct{
+	int			fd[COUNTER_COUNT];		///< perf event file descriptor, or -1 if unavailable
+} benchmarkCounters_t;
+
+/// Counter values over one run
+typedef struct{
+	uint64_t	value[COUNTER_COUNT];	///< event count
+	bool		valid[COUNTER_COUNT];	///< event was counted
+} benchmarkCounterValues_t;
+
+/// Open all counters that are available on this system.
+void benchmarkCountersOpen(
+	benchmarkCounters_t * const			pCounters	///< [out] counters
+);
+
+/// Reset and enable the counters.
+void benchmarkCountersStart(
+	const benchmarkCounters_t * const	pCounters	///< [in] counters
+);
+
+/// Disable and read the counters.
+void benchmarkCountersStop(
+	const benchmarkCounters_t * const	pCounters,	///< [in] counters
+	benchmarkCounterValues_t * const	pValues		///< [out] counts since benchmarkCountersStart()
+);
+
+/// Close the counters.
+void benchmarkCountersClose(
+	benchmarkCounters_t * const			pCounters	///< [in,out] counters
+);
+
+/// \returns JSON key of a counter
+const char * benchmarkCounterName(
+	const benchmarkCounter_t			counter		///< [in] counter
+);
+
+#endif // BENCHMARKCOUNTERS_H_
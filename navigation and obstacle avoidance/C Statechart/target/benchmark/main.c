@@ -0,0 +1,703 @@
+/** \file main.c
+ *
+ * Microbenchmarks for the statechart and the code around it: one statechart
+ * step against the lookup-table step of irobotNavTableStatechart.c, Group 6
+ * sensor packet decoding, the hill-climb trigonometry, the accelerometer
+ * filter, and a mission resume against the equivalent hand-coded switch.
+ * Each benchmark runs on a realistic and an adversarial input distribution.
+ * Results are written to stdout as JSON.
+ *
+ * Build (Linux), from this directory:
+ *	gcc -O2 -I../.. -I../../.. -I../../../irobot -o benchmark main.c benchmarkCounters.c
+ *		../../accelerometerFilter.c ../../irobotMission.c ../../irobotStatechartCoverage.c
+ *		../../irobotNavigationStatechart.c
+ *		../../../irobot/irobotSensorStream.c ../../../irobot/xqueue.c ... -lm
+ *
+ * Define BENCHMARK_VARIANT to label the statechart source that was linked,
+ * and STATECHART_COVERAGE to measure the cost of transition coverage. To
+ * compare every variant in one run, define IROBOT_STATECHART_VARIANTS and
+ * link all of them with ../../irobotStatechartVariants.c instead of
+ * ../../irobotNavigationStatechart.c; the statechart benchmarks then run
+ * once per variant.
+ *
+ * Usage:
+ *	benchmark [name filter]
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "benchmarkCounters.h"
+#include "irobotNavigationStatechart.h"
+#include "accelerometerFilter.h"
+#include "irobotHillClimb.h"
+#include "irobotMission.h"
+#include "irobotNavStatechartTable.h"
+#include "irobotNavStatechartTableData.h"
+#include "irobotSensorStream.h"
+#include "irobotSensorTypes.h"
+#include "xqueue.h"
+#ifdef IROBOT_STATECHART_VARIANTS
+	#include "irobotStatechartVariants.h"
+#endif
+
+#ifndef BENCHMARK_VARIANT
+	#ifdef IROBOT_STATECHART_VARIANTS
+		#define BENCHMARK_VARIANT	"irobotStatechartVariants.c"
+	#else
+		#define BENCHMARK_VARIANT	"irobotNavigationStatechart.c"
+	#endif
+#endif
+
+#define INPUT_COUNT			4096		///< inputs per distribution; power of 2
+#define INPUT_MASK			(INPUT_COUNT - 1)
+#define OPS_PER_RUN			(INPUT_COUNT * 64)	///< operations timed per run
+#define RUNS				7			///< timed runs per benchmark; the fastest is reported
+#define STREAM_PACKET_SIZE	(SENSOR_GROUP6_SIZE + 4)	///< header, size, packet id, data, checksum
+
+/// Benchmark case
+typedef struct{
+	const char *	name;					///< operation being measured
+	const char *	input;					///< input distribution
+	void			(*setup)(void);			///< generate inputs; not timed
+	void			(*run)(const uint32_t nOps);	///< execute nOps operations
+	bool			perVariant;				///< run once for each statechart variant
+} benchmarkCase_t;
+
+/// One statechart execution
+typedef struct{
+	int32_t					netDistance;	///< net distance, in mm
+	int32_t					netAngle;		///< net angle, in deg
+	irobotSensorGroup6_t	sensors;		///< sensors
+	accelerometer_t			accel;			///< filtered accelerometer, in g
+} statechartInput_t;
+
+/// One accelerometer filter update
+typedef struct{
+	accelerometer_t			sample;			///< raw accelerometer, in g
+	uint32_t				periodMs;		///< time since previous sample, in ms
+} accelInput_t;
+
+// inputs for the case being run
+static statechartInput_t	statechartInputs[INPUT_COUNT];
+static uint8_t				packetInputs[INPUT_COUNT][STREAM_PACKET_SIZE];
+static accelInput_t			accelInputs[INPUT_COUNT];
+
+/// Statechart context, as saved by the statechart
+typedef struct{
+	uint8_t					bytes[STATECHART_CONTEXT_MAX_SIZE];	///< context
+	size_t					size;			///< size of the context, in bytes
+} statechartContext_t;
+
+// statechart being measured, and its context before it first executed
+static irobotNavigationStatechart_t					statechart = irobotNavigationStatechart;
+static irobotNavigationStatechartContextRestore_t	statechartContextRestore = irobotNavigationStatechartContextRestore;
+static const statechartContext_t *					pStatechartInitial;
+
+// results are accumulated here so the compiler cannot discard the work
+static volatile int64_t		sink;
+
+static uint64_t				randomState = 0x2545F4914F6CDD1DULL;
+
+/// xorshift64; deterministic so that runs are comparable
+static uint32_t randomNext(void){
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 7;
+	randomState ^= randomState << 17;
+	return (uint32_t)(randomState >> 32);
+}
+
+/// \returns true with probability 1/n
+static bool randomOneIn(const uint32_t n){
+	return randomNext() % n == 0;
+}
+
+/// \returns uniform double in [-1, 1]
+static double randomUnit(void){
+	return (double)randomNext() / 2147483648.0 - 1.0;
+}
+
+static uint64_t clockNs(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+//*****************************************************
+// statechart step                                    *
+//*****************************************************
+
+/// Execute the statechart once with the play button pressed or released.
+/// \returns period requested by the statechart, in ms
+static uint32_t statechartPlay(const bool play){
+	irobotSensorGroup6_t	sensors;
+	const accelerometer_t	accel = {0, 0, 1};
+	int16_t					leftWheelSpeed;
+	int16_t					rightWheelSpeed;
+
+	memset(&sensors, 0, sizeof(sensors));
+	sensors.buttons.play = play;
+	return statechart(0, 0, sensors, accel, true, &rightWheelSpeed, &leftWheelSpeed);
+}
+
+/// Driving through a room: long straight legs, an obstacle every few
+/// hundred ticks, turns and occasional ramps.
+static void statechartSetupRealistic(void){
+	int32_t		netDistance = 0;
+	int32_t		netAngle = 0;
+	uint32_t	obstacleTicks = 0;
+	uint32_t	rampTicks = 0;
+	bool		obstacleLeft = false;
+	uint32_t	i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		statechartInput_t * const pInput = &statechartInputs[i];
+
+		memset(pInput, 0, sizeof(*pInput));
+		if(obstacleTicks == 0 && randomOneIn(300)){
+			obstacleTicks = 2 + randomNext() % 3;
+			obstacleLeft = randomOneIn(2);
+		}
+		if(rampTicks == 0 && randomOneIn(800)){
+			rampTicks = 100;
+		}
+
+		if(obstacleTicks > 0){
+			obstacleTicks--;
+			pInput->sensors.bumps_wheelDrops.bumpLeft = obstacleLeft;
+			pInput->sensors.bumps_wheelDrops.bumpRight = !obstacleLeft;
+			pInput->sensors.wall = obstacleLeft;
+			netDistance -= 12;
+			netAngle += obstacleLeft ? -1 : 1;
+		}
+		else{
+			netDistance += 12;
+			netAngle += (int32_t)(randomNext() % 3) - 1;
+		}
+
+		pInput->netDistance = netDistance;
+		pInput->netAngle = netAngle;
+		pInput->sensors.distance = 12;
+		pInput->accel.z = 1;
+		if(rampTicks > 0){
+			rampTicks--;
+			pInput->accel.x = 0.15 + 0.01 * randomUnit();
+			pInput->accel.y = 0.02 * randomUnit();
+		}
+		else{
+			pInput->accel.x = 0.01 * randomUnit();
+			pInput->accel.y = 0.01 * randomUnit();
+		}
+	}
+
+	// start from the initial state, whatever earlier cases left behind, and
+	// leave the pause region before timing
+	if(!statechartContextRestore(pStatechartInitial->bytes, pStatechartInitial->size)){
+		fprintf(stderr, "benchmark: cannot restore the initial statechart context\n");
+		exit(EXIT_FAILURE);
+	}
+	statechartPlay(false);
+	statechartPlay(true);
+	if(statechartPlay(false) == STATECHART_PERIOD_PAUSE_MS){
+		fprintf(stderr, "benchmark: statechart still paused after setup\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+/// Independent random inputs every tick, so that no transition is predictable.
+static void statechartSetupAdversarial(void){
+	uint32_t i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		statechartInput_t * const pInput = &statechartInputs[i];
+
+		memset(pInput, 0, sizeof(*pInput));
+		pInput->netDistance = (int32_t)(randomNext() % 2000) - 1000;
+		pInput->netAngle = (int32_t)(randomNext() % 360) - 180;
+		pInput->sensors.buttons.play = randomOneIn(4);
+		pInput->sensors.bumps_wheelDrops.bumpLeft = randomOneIn(8);
+		pInput->sensors.bumps_wheelDrops.bumpRight = randomOneIn(8);
+		pInput->sensors.bumps_wheelDrops.wheeldropLeft = randomOneIn(8);
+		pInput->sensors.bumps_wheelDrops.wheeldropRight = randomOneIn(8);
+		pInput->sensors.wall = randomOneIn(8);
+		pInput->sensors.cliffLeft = randomOneIn(8);
+		pInput->sensors.cliffFrontLeft = randomOneIn(8);
+		pInput->sensors.cliffFrontRight = randomOneIn(8);
+		pInput->sensors.cliffRight = randomOneIn(8);
+		pInput->accel.x = 0.25 * randomUnit();
+		pInput->accel.y = 0.25 * randomUnit();
+		pInput->accel.z = 1;
+	}
+}
+
+static void statechartRun(const uint32_t nOps){
+	int16_t		leftWheelSpeed = 0;
+	int16_t		rightWheelSpeed = 0;
+	int64_t		sum = 0;
+	uint32_t	i;
+
+	for(i = 0; i < nOps; i++){
+		const statechartInput_t * const pInput = &statechartInputs[i & INPUT_MASK];
+
+		sum += statechart(
+			pInput->netDistance,
+			pInput->netAngle,
+			pInput->sensors,
+			pInput->accel,
+			true,
+			&rightWheelSpeed,
+			&leftWheelSpeed
+		);
+		sum += leftWheelSpeed - rightWheelSpeed;
+	}
+	sink += sum;
+}
+
+//*****************************************************
+// table statechart step                              *
+//*****************************************************
+
+/// irobotNavStatechart.c compiled to a table, inlined; uses the statechart inputs
+static void tableRun(const uint32_t nOps){
+	navTableState_t	tableState = {navTableStateIndex(NAVTABLE_DRIVE, NAVTABLE_DRIVE, 0), 0, 0};
+	int16_t			leftWheelSpeed = 0;
+	int16_t			rightWheelSpeed = 0;
+	int64_t			sum = 0;
+	uint32_t		i;
+
+	for(i = 0; i < nOps; i++){
+		const statechartInput_t * const pInput = &statechartInputs[i & INPUT_MASK];
+
+		sum += navTableStep(navTable, navTableOutputs, &tableState,
+			pInput->netDistance, pInput->netAngle, pInput->sensors, &rightWheelSpeed, &leftWheelSpeed);
+		sum += leftWheelSpeed - rightWheelSpeed;
+	}
+	sink += sum;
+}
+
+//*****************************************************
+// Group 6 packet decoding                            *
+//*****************************************************
+
+/// Fill one stream packet with random sensor data and a valid checksum.
+static void packetGenerate(uint8_t * const pPacket){
+	uint8_t		checksum = 0;
+	uint32_t	i;
+
+	pPacket[0] = 19;						// stream header
+	pPacket[1] = SENSOR_GROUP6_SIZE + 1;	// packet id and data
+	pPacket[2] = 6;							// packet id
+	for(i = 3; i < STREAM_PACKET_SIZE - 1; i++){
+		pPacket[i] = (uint8_t)randomNext();
+	}
+	for(i = 0; i < STREAM_PACKET_SIZE - 1; i++){
+		checksum += pPacket[i];
+	}
+	pPacket[STREAM_PACKET_SIZE - 1] = (uint8_t)(0x100 - checksum);
+}
+
+static void packetSetupValid(void){
+	uint32_t i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		packetGenerate(packetInputs[i]);
+	}
+}
+
+/// One in four packets has a corrupt byte, so the checksum fails at random.
+static void packetSetupCorrupt(void){
+	uint32_t i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		packetGenerate(packetInputs[i]);
+		if(randomOneIn(4)){
+			packetInputs[i][randomNext() % STREAM_PACKET_SIZE] ^= (uint8_t)(1 + randomNext() % 255);
+		}
+	}
+}
+
+static void packetRun(const uint32_t nOps){
+	xqueue_t				queue;
+	uint8_t					queueBuffer[SENSOR_SIZE_UPPER_BOUND];
+	irobotSensorGroup6_t	sensors;
+	bool					packetFound;
+	int64_t					sum = 0;
+	uint32_t				i;
+
+	// decode the way the simulator target does: one packet per queue
+	for(i = 0; i < nOps; i++){
+		packetFound = false;
+		xqueue_init(&queue, queueBuffer, SENSOR_SIZE_UPPER_BOUND);
+		xqueue_push_buffer(&queue, packetInputs[i & INPUT_MASK], STREAM_PACKET_SIZE);
+		if(irobotSensorStreamProcessAll(&queue, &sensors, &packetFound) >= 0 && packetFound){
+			sum += sensors.distance + sensors.angle;
+		}
+	}
+	sink += sum;
+}
+
+//*****************************************************
+// hill-climb trigonometry                            *
+//*****************************************************
+
+/// Level ground with sensor noise, and ramps near hillThreshold.
+static void trigSetupRealistic(void){
+	uint32_t i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		statechartInputs[i].accel.x = (i & 512 ? 0.15 : 0) + 0.01 * randomUnit();
+		statechartInputs[i].accel.y = 0.01 * randomUnit();
+		statechartInputs[i].accel.z = 1;
+	}
+}
+
+/// Arbitrary orientations, including zero vectors where atan2() takes its slow path.
+static void trigSetupAdversarial(void){
+	uint32_t i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		statechartInputs[i].accel.x = randomOneIn(16) ? 0 : randomUnit();
+		statechartInputs[i].accel.y = randomOneIn(16) ? 0 : randomUnit();
+		statechartInputs[i].accel.z = randomUnit();
+	}
+}
+
+/// Inputs and CLIMB actions of irobotHillClimbStatechart.c, through the
+/// functions the statechart calls
+static void trigRun(const uint32_t nOps){
+	const int32_t	driveSpeed = 200;
+	int16_t			leftWheelSpeed;
+	int16_t			rightWheelSpeed;
+	int64_t			sum = 0;
+	uint32_t		i;
+
+	for(i = 0; i < nOps; i++){
+		const accelerometer_t accel = statechartInputs[i & INPUT_MASK].accel;
+		const double inclination = hillClimbInclination(accel);
+		const double tilt = hillClimbTilt(accel, 0);
+
+		hillClimbWheelSpeeds(driveSpeed, tilt, &rightWheelSpeed, &leftWheelSpeed);
+		sum += (int64_t)inclination + leftWheelSpeed - rightWheelSpeed;
+	}
+	sink += sum;
+}
+
+//*****************************************************
+// accelerometer filter                               *
+//*****************************************************
+
+/// Noisy samples at a period that changes only with the statechart state.
+static void accelSetupRealistic(void){
+	uint32_t	periodMs = STATECHART_PERIOD_DRIVE_MS;
+	uint32_t	i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		if(randomOneIn(100)){
+			periodMs = periodMs == STATECHART_PERIOD_DRIVE_MS ? STATECHART_PERIOD_MANEUVER_MS : STATECHART_PERIOD_DRIVE_MS;
+		}
+		accelInputs[i].sample.x = 0.05 * randomUnit();
+		accelInputs[i].sample.y = 0.05 * randomUnit();
+		accelInputs[i].sample.z = 1 + 0.05 * randomUnit();
+		accelInputs[i].periodMs = periodMs;
+	}
+}
+
+/// A different period every sample, forcing the coefficient to be recomputed.
+static void accelSetupAdversarial(void){
+	static const uint32_t periods[3] = {STATECHART_PERIOD_MANEUVER_MS, STATECHART_PERIOD_DRIVE_MS, STATECHART_PERIOD_PAUSE_MS};
+	uint32_t i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		accelInputs[i].sample.x = randomUnit();
+		accelInputs[i].sample.y = randomUnit();
+		accelInputs[i].sample.z = randomUnit();
+		accelInputs[i].periodMs = periods[i % 3];
+	}
+}
+
+static void accelRun(const uint32_t nOps){
+	accelerometerFilter_t	filter;
+	accelerometer_t			value = {0, 0, 0};
+	uint32_t				i;
+
+	accelerometerFilterInit(&filter, 0.2);
+	for(i = 0; i < nOps; i++){
+		const accelInput_t * const pInput = &accelInputs[i & INPUT_MASK];
+
+		value = accelerometerFilterUpdate(&filter, pInput->sample, pInput->periodMs);
+	}
+	sink += (int64_t)(value.x * 1000) + (int64_t)(value.y * 1000) + (int64_t)(value.z * 1000);
+}
+
+//*****************************************************
+// mission resume                                     *
+//*****************************************************
+
+/// Legs of the waypoint chart, written as a mission
+static void benchmarkMission(irobotMission_t * const pMission){
+	MISSION_BEGIN(pMission);
+	MISSION_TURN_RIGHT(pMission, 79, 100);
+	MISSION_DRIVE(pMission, 800, 200);
+	MISSION_TURN_LEFT(pMission, 88, 100);
+	MISSION_DRIVE(pMission, 1500, 200);
+	MISSION_TURN_LEFT(pMission, 89, 100);
+	MISSION_DRIVE(pMission, 1000, 200);
+	MISSION_TURN_RIGHT(pMission, 50, 100);
+	MISSION_DRIVE(pMission, 900, 200);
+	MISSION_END(pMission);
+}
+
+/// The same legs, hand-coded the way the waypoint chart used to be
+typedef enum{
+	SWITCH_TURN = 0,
+	SWITCH_DRIVE,
+	SWITCH_TURN_LEFT,
+	SWITCH_DRIVE2,
+	SWITCH_TURN_LEFT2,
+	SWITCH_DRIVE3,
+	SWITCH_TURN2,
+	SWITCH_DRIVE4,
+	SWITCH_DONE
+} switchLeg_t;
+
+/// Netted distance and angle grow steadily, so legs complete at regular intervals.
+static void missionSetupRealistic(void){
+	uint32_t i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		statechartInputs[i].netDistance = (int32_t)i * 12;
+		statechartInputs[i].netAngle = (int32_t)i * 3;
+	}
+}
+
+/// Irregular progress, so the tick on which a leg completes is unpredictable.
+static void missionSetupAdversarial(void){
+	int32_t		netDistance = 0;
+	int32_t		netAngle = 0;
+	uint32_t	i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		netDistance += (int32_t)(randomNext() % 48);
+		netAngle += (int32_t)(randomNext() % 12);
+		statechartInputs[i].netDistance = netDistance;
+		statechartInputs[i].netAngle = netAngle;
+	}
+}
+
+static void missionRun(const uint32_t nOps){
+	irobotMission_t		mission;
+	int64_t				sum = 0;
+	uint32_t			i;
+
+	irobotMissionStart(&mission, 0);
+	for(i = 0; i < nOps; i++){
+		const statechartInput_t * const pInput = &statechartInputs[i & INPUT_MASK];
+
+		if(!irobotMissionResume(&mission, benchmarkMission, pInput->netDistance, pInput->netAngle)){
+			irobotMissionStart(&mission, 0);
+		}
+		sum += mission.leftWheelSpeed - mission.rightWheelSpeed;
+	}
+	sink += sum;
+}
+
+static void switchRun(const uint32_t nOps){
+	switchLeg_t		leg = SWITCH_TURN;
+	int32_t			distanceAtManeuverStart = statechartInputs[0].netDistance;
+	int32_t			angleAtManeuverStart = statechartInputs[0].netAngle;
+	int16_t			leftWheelSpeed = 0;
+	int16_t			rightWheelSpeed = 0;
+	int64_t			sum = 0;
+	uint32_t		i;
+
+	for(i = 0; i < nOps; i++){
+		const int32_t netDistance = statechartInputs[i & INPUT_MASK].netDistance;
+		const int32_t netAngle = statechartInputs[i & INPUT_MASK].netAngle;
+		const switchLeg_t previousLeg = leg;
+
+		if(leg == SWITCH_DONE){
+			leg = SWITCH_TURN;
+		}
+		else if(leg == SWITCH_TURN && abs(netAngle - angleAtManeuverStart) >= 79){
+			leg = SWITCH_DRIVE;
+		}
+		else if(leg == SWITCH_DRIVE && abs(netDistance - distanceAtManeuverStart) >= 800){
+			leg = SWITCH_TURN_LEFT;
+		}
+		else if(leg == SWITCH_TURN_LEFT && abs(netAngle - angleAtManeuverStart) >= 88){
+			leg = SWITCH_DRIVE2;
+		}
+		else if(leg == SWITCH_DRIVE2 && abs(netDistance - distanceAtManeuverStart) >= 1500){
+			leg = SWITCH_TURN_LEFT2;
+		}
+		else if(leg == SWITCH_TURN_LEFT2 && abs(netAngle - angleAtManeuverStart) >= 89){
+			leg = SWITCH_DRIVE3;
+		}
+		else if(leg == SWITCH_DRIVE3 && abs(netDistance - distanceAtManeuverStart) >= 1000){
+			leg = SWITCH_TURN2;
+		}
+		else if(leg == SWITCH_TURN2 && abs(netAngle - angleAtManeuverStart) >= 50){
+			leg = SWITCH_DRIVE4;
+		}
+		else if(leg == SWITCH_DRIVE4 && abs(netDistance - distanceAtManeuverStart) >= 900){
+			leg = SWITCH_DONE;
+		}
+		if(leg != previousLeg){
+			distanceAtManeuverStart = netDistance;
+			angleAtManeuverStart = netAngle;
+		}
+
+		switch(leg){
+		case SWITCH_DRIVE:
+		case SWITCH_DRIVE2:
+		case SWITCH_DRIVE3:
+		case SWITCH_DRIVE4:
+			leftWheelSpeed = rightWheelSpeed = 200;
+			break;
+		case SWITCH_TURN:
+		case SWITCH_TURN2:
+			leftWheelSpeed = 100;
+			rightWheelSpeed = -100;
+			break;
+		case SWITCH_TURN_LEFT:
+		case SWITCH_TURN_LEFT2:
+			leftWheelSpeed = -100;
+			rightWheelSpeed = 100;
+			break;
+		default:
+			leftWheelSpeed = rightWheelSpeed = 0;
+			break;
+		}
+		sum += leftWheelSpeed - rightWheelSpeed;
+	}
+	sink += sum;
+}
+
+//*****************************************************
+// driver                                             *
+//*****************************************************
+
+static const benchmarkCase_t cases[] = {
+	{"statechart_step",		"realistic",	statechartSetupRealistic,	statechartRun,	true},
+	{"statechart_step",		"adversarial",	statechartSetupAdversarial,	statechartRun,	true},
+	{"table_step",			"realistic",	statechartSetupRealistic,	tableRun,		false},
+	{"table_step",			"adversarial",	statechartSetupAdversarial,	tableRun,		false},
+	{"group6_decode",		"valid",		packetSetupValid,			packetRun,		false},
+	{"group6_decode",		"corrupt",		packetSetupCorrupt,			packetRun,		false},
+	{"hillclimb_trig",		"realistic",	trigSetupRealistic,			trigRun,			false},
+	{"hillclimb_trig",		"adversarial",	trigSetupAdversarial,		trigRun,			false},
+	{"accel_filter",		"realistic",	accelSetupRealistic,		accelRun,		false},
+	{"accel_filter",		"adversarial",	accelSetupAdversarial,		accelRun,		false},
+	{"mission_resume",		"realistic",	missionSetupRealistic,		missionRun,		false},
+	{"mission_resume",		"adversarial",	missionSetupAdversarial,	missionRun,		false},
+	{"switch_resume",		"realistic",	missionSetupRealistic,		switchRun,		false},
+	{"switch_resume",		"adversarial",	missionSetupAdversarial,	switchRun,		false},
+};
+
+/// Time one case and write its JSON object.
+static void benchmarkRun(
+	const benchmarkCase_t * const		pCase,
+	const char * const					variant,
+	const benchmarkCounters_t * const	pCounters,
+	const bool							first
+){
+	benchmarkCounterValues_t	values;
+	benchmarkCounterValues_t	bestValues;
+	uint64_t					bestNs = UINT64_MAX;
+	uint32_t					run;
+	int							counter;
+
+	pCase->setup();
+	pCase->run(INPUT_COUNT);		// warm caches and predictors
+
+	memset(&bestValues, 0, sizeof(bestValues));
+	for(run = 0; run < RUNS; run++){
+		uint64_t ns = clockNs();
+
+		benchmarkCountersStart(pCounters);
+		pCase->run(OPS_PER_RUN);
+		benchmarkCountersStop(pCounters, &values);
+		ns = clockNs() - ns;
+
+		if(ns < bestNs){
+			bestNs = ns;
+			bestValues = values;
+		}
+	}
+
+	printf("%s\n\t\t{\"name\": \"%s\", \"input\": \"%s\"", first ? "" : ",", pCase->name, pCase->input);
+	if(variant){
+		printf(", \"variant\": \"%s\"", variant);
+	}
+	printf(", \"ops\": %u, \"ns_per_op\": %.3f", OPS_PER_RUN, (double)bestNs / OPS_PER_RUN);
+	for(counter = 0; counter < COUNTER_COUNT; counter++){
+		if(bestValues.valid[counter]){
+			printf(", \"%s_per_op\": %.3f", benchmarkCounterName(counter), (double)bestValues.value[counter] / OPS_PER_RUN);
+		}
+		else{
+			printf(", \"%s_per_op\": null", benchmarkCounterName(counter));
+		}
+	}
+	printf("}");
+}
+
+int main(int argc, char **argv)
+{
+	const char * const		filter = argc > 1 ? argv[1] : NULL;
+	benchmarkCounters_t		counters;
+	statechartContext_t *	initialContexts;	// one per variant, saved before any case executes it
+	bool					first = true;
+	size_t					i;
+
+#ifdef IROBOT_STATECHART_VARIANTS
+	initialContexts = calloc(irobotStatechartVariantCount, sizeof(*initialContexts));
+	for(i = 0; initialContexts && i < irobotStatechartVariantCount; i++){
+		initialContexts[i].size = irobotStatechartVariants[i].contextSave(initialContexts[i].bytes, sizeof(initialContexts[i].bytes));
+	}
+#else
+	initialContexts = calloc(1, sizeof(*initialContexts));
+	if(initialContexts){
+		initialContexts[0].size = irobotNavigationStatechartContextSave(initialContexts[0].bytes, sizeof(initialContexts[0].bytes));
+	}
+#endif
+	if(!initialContexts){
+		fprintf(stderr, "benchmark: out of memory\n");
+		return EXIT_FAILURE;
+	}
+	pStatechartInitial = &initialContexts[0];
+
+	benchmarkCountersOpen(&counters);
+
+	printf("{\n\t\"variant\": \"%s\",\n\t\"benchmarks\": [", BENCHMARK_VARIANT);
+	for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++){
+		if(filter && !strstr(cases[i].name, filter)){
+			continue;
+		}
+#ifdef IROBOT_STATECHART_VARIANTS
+		if(cases[i].perVariant){
+			size_t v;
+
+			for(v = 0; v < irobotStatechartVariantCount; v++){
+				statechart = irobotStatechartVariants[v].statechart;
+				statechartContextRestore = irobotStatechartVariants[v].contextRestore;
+				pStatechartInitial = &initialContexts[v];
+				benchmarkRun(&cases[i], irobotStatechartVariants[v].name, &counters, first);
+				first = false;
+			}
+			continue;
+		}
+#endif
+		benchmarkRun(&cases[i], NULL, &counters, first);
+		first = false;
+	}
+	printf("\n\t]\n}\n");
+
+	benchmarkCountersClose(&counters);
+	free(initialContexts);
+
+	return 0;
+}
@@ -0,0 +1,373 @@
+/** \file irobotCaptureParser.c
+ *
+ * Parallel parser for raw UART captures of the sensor stream.
+ *
+ * Pass 1 splits the capture into one chunk per thread. Each thread scans
+ * its chunk the way a serial parser would: a valid packet is taken whole,
+ * anything else is skipped up to the next header byte. A thread starts in
+ * the middle of whatever packet straddles its chunk boundary, so it may
+ * lock on to a false packet inside real sensor data. The merge walks the
+ * chunks in order and rescans serially from where the previous chunk's
+ * scan stopped, until it reaches a byte that the chunk's own scan also
+ * examined; from there on, both scans agree and the chunk's packets are
+ * taken as found. This is rarely more than one packet of bytes.
+ *
+ * Pass 2 decodes the packets into columns, again one range per thread.
+ */
+
+#define _GNU_SOURCE
+#include "irobotCaptureParser.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MIN_CHUNK_SIZE		65536		// smallest chunk worth a thread, in bytes
+#define MAX_THREADS			256			// largest number of threads
+
+/// Chunk of the capture scanned by one thread
+typedef struct{
+	const uint8_t *		bytes;			// capture
+	uint64_t			nBytes;			// size of the capture, in bytes
+	uint64_t			start;			// first byte of the chunk
+	uint64_t			end;			// first byte after the chunk
+	uint64_t *			offsets;		// offsets of the packets found
+	uint64_t			nOffsets;		// number of packets found
+	uint64_t			resume;			// position of the scan after the chunk
+} captureChunk_t;
+
+/// Range of packets decoded by one thread
+typedef struct{
+	const uint8_t *					bytes;		// capture
+	irobotSensorGroup6Columns_t *	pColumns;	// columns; offsets filled in
+	uint64_t						first;		// first row to decode
+	uint64_t						last;		// row after the last row to decode
+	uint64_t						nResyncs;	// packets not immediately following the previous one
+} captureRange_t;
+
+bool irobotCaptureIsPacket(const uint8_t * const bytes, const uint64_t nBytes, const uint64_t offset){
+	const uint8_t * const	packet = bytes + offset;
+	uint8_t					checksum = 0;
+	uint32_t				i;
+
+	if(	  offset + CAPTURE_PACKET_SIZE > nBytes
+	   || packet[0] != CAPTURE_STREAM_HEADER
+	   || packet[1] != CAPTURE_GROUP6_SIZE + 1
+	   || packet[2] != CAPTURE_GROUP6_ID
+	){
+		return false;
+	}
+
+	for(i = 0; i < CAPTURE_PACKET_SIZE; i++){
+		checksum += packet[i];
+	}
+	return checksum == 0;
+}
+
+/// Scan from a position up to the end of a range, appending the packets found.
+/// \returns position of the scan after the range
+static uint64_t captureScan(
+	const uint8_t * const	bytes,
+	const uint64_t			nBytes,
+	uint64_t				position,
+	const uint64_t			end,
+	uint64_t * const		offsets,
+	uint64_t * const		pNOffsets
+){
+	while(position < end){
+		if(irobotCaptureIsPacket(bytes, nBytes, position)){
+			offsets[(*pNOffsets)++] = position;
+			position += CAPTURE_PACKET_SIZE;
+		}
+		else{
+			// resynchronize on the next header byte
+			const uint8_t * const next = memchr(bytes + position + 1, CAPTURE_STREAM_HEADER, end - position - 1);
+			position = next ? (uint64_t)(next - bytes) : end;
+		}
+	}
+	return position;
+}
+
+static void * captureScanChunk(void * const pArg){
+	captureChunk_t * const pChunk = (captureChunk_t *)pArg;
+
+	pChunk->resume = captureScan(pChunk->bytes, pChunk->nBytes, pChunk->start, pChunk->end, pChunk->offsets, &pChunk->nOffsets);
+	return NULL;
+}
+
+/// Join the packets of each chunk into one list, as a serial scan would have found them.
+/// \returns number of packets
+static uint64_t captureMerge(
+	const uint8_t * const			bytes,
+	const uint64_t					nBytes,
+	const captureChunk_t * const	chunks,
+	const uint32_t					nChunks,
+	uint64_t * const				offsets
+){
+	uint64_t	nOffsets = 0;
+	uint64_t	position = 0;		// position of the serial scan
+	uint32_t	k;
+
+	for(k = 0; k < nChunks; k++){
+		const captureChunk_t * const pChunk = &chunks[k];
+		uint64_t j = 0;
+
+		while(position < pChunk->end){
+			if(position >= pChunk->start){
+				// skip the chunk's packets that end before the serial scan
+				while(j < pChunk->nOffsets && pChunk->offsets[j] + CAPTURE_PACKET_SIZE <= position){
+					j++;
+				}
+				if(j == pChunk->nOffsets || pChunk->offsets[j] >= position){
+					// the chunk's scan examined this byte too; the scans agree from here on
+					memcpy(&offsets[nOffsets], &pChunk->offsets[j], (pChunk->nOffsets - j) * sizeof(*offsets));
+					nOffsets += pChunk->nOffsets - j;
+					position = pChunk->resume;
+					break;
+				}
+			}
+
+			if(irobotCaptureIsPacket(bytes, nBytes, position)){
+				offsets[nOffsets++] = position;
+				position += CAPTURE_PACKET_SIZE;
+			}
+			else{
+				position++;
+			}
+		}
+	}
+	return nOffsets;
+}
+
+static uint16_t getUint16(const uint8_t * const bytes){
+	return (uint16_t)((bytes[0] << 8) | bytes[1]);
+}
+
+static void * captureDecodeRange(void * const pArg){
+	captureRange_t * const				pRange = (captureRange_t *)pArg;
+	irobotSensorGroup6Columns_t * const	c = pRange->pColumns;
+	uint64_t							i;
+
+	pRange->nResyncs = 0;
+	for(i = pRange->first; i < pRange->last; i++){
+		const uint8_t * const data = pRange->bytes + c->offset[i] + 3;
+		const uint64_t expected = i == 0 ? 0 : c->offset[i - 1] + CAPTURE_PACKET_SIZE;
+
+		pRange->nResyncs += c->offset[i] != expected;
+
+		c->bumpsWheelDrops[i] = data[0];
+		c->wall[i] = data[1];
+		c->cliffLeft[i] = data[2];
+		c->cliffFrontLeft[i] = data[3];
+		c->cliffFrontRight[i] = data[4];
+		c->cliffRight[i] = data[5];
+		c->virtualWall[i] = data[6];
+		c->overcurrents[i] = data[7];
+		c->irOpcode[i] = data[10];
+		c->buttons[i] = data[11];
+		c->distance[i] = (int16_t)getUint16(&data[12]);
+		c->angle[i] = (int16_t)getUint16(&data[14]);
+		c->chargingState[i] = data[16];
+		c->voltage[i] = getUint16(&data[17]);
+		c->current[i] = (int16_t)getUint16(&data[19]);
+		c->batteryTemperature[i] = (int8_t)data[21];
+		c->batteryCharge[i] = getUint16(&data[22]);
+		c->batteryCapacity[i] = getUint16(&data[24]);
+		c->wallSignal[i] = getUint16(&data[26]);
+		c->cliffLeftSignal[i] = getUint16(&data[28]);
+		c->cliffFrontLeftSignal[i] = getUint16(&data[30]);
+		c->cliffFrontRightSignal[i] = getUint16(&data[32]);
+		c->cliffRightSignal[i] = getUint16(&data[34]);
+		c->oiMode[i] = data[40];
+		c->songNumber[i] = data[41];
+		c->songPlaying[i] = data[42];
+		c->requestedVelocity[i] = (int16_t)getUint16(&data[44]);
+		c->requestedRadius[i] = (int16_t)getUint16(&data[46]);
+		c->requestedRightVelocity[i] = (int16_t)getUint16(&data[48]);
+		c->requestedLeftVelocity[i] = (int16_t)getUint16(&data[50]);
+	}
+	return NULL;
+}
+
+/// Allocate every column but the offsets.
+/// \returns false if out of memory
+static bool columnsAllocate(irobotSensorGroup6Columns_t * const c, const size_t n){
+	const size_t rows = n > 0 ? n : 1;
+
+	c->bumpsWheelDrops = malloc(rows * sizeof(*c->bumpsWheelDrops));
+	c->wall = malloc(rows * sizeof(*c->wall));
+	c->cliffLeft = malloc(rows * sizeof(*c->cliffLeft));
+	c->cliffFrontLeft = malloc(rows * sizeof(*c->cliffFrontLeft));
+	c->cliffFrontRight = malloc(rows * sizeof(*c->cliffFrontRight));
+	c->cliffRight = malloc(rows * sizeof(*c->cliffRight));
+	c->virtualWall = malloc(rows * sizeof(*c->virtualWall));
+	c->overcurrents = malloc(rows * sizeof(*c->overcurrents));
+	c->irOpcode = malloc(rows * sizeof(*c->irOpcode));
+	c->buttons = malloc(rows * sizeof(*c->buttons));
+	c->distance = malloc(rows * sizeof(*c->distance));
+	c->angle = malloc(rows * sizeof(*c->angle));
+	c->chargingState = malloc(rows * sizeof(*c->chargingState));
+	c->voltage = malloc(rows * sizeof(*c->voltage));
+	c->current = malloc(rows * sizeof(*c->current));
+	c->batteryTemperature = malloc(rows * sizeof(*c->batteryTemperature));
+	c->batteryCharge = malloc(rows * sizeof(*c->batteryCharge));
+	c->batteryCapacity = malloc(rows * sizeof(*c->batteryCapacity));
+	c->wallSignal = malloc(rows * sizeof(*c->wallSignal));
+	c->cliffLeftSignal = malloc(rows * sizeof(*c->cliffLeftSignal));
+	c->cliffFrontLeftSignal = malloc(rows * sizeof(*c->cliffFrontLeftSignal));
+	c->cliffFrontRightSignal = malloc(rows * sizeof(*c->cliffFrontRightSignal));
+	c->cliffRightSignal = malloc(rows * sizeof(*c->cliffRightSignal));
+	c->oiMode = malloc(rows * sizeof(*c->oiMode));
+	c->songNumber = malloc(rows * sizeof(*c->songNumber));
+	c->songPlaying = malloc(rows * sizeof(*c->songPlaying));
+	c->requestedVelocity = malloc(rows * sizeof(*c->requestedVelocity));
+	c->requestedRadius = malloc(rows * sizeof(*c->requestedRadius));
+	c->requestedRightVelocity = malloc(rows * sizeof(*c->requestedRightVelocity));
+	c->requestedLeftVelocity = malloc(rows * sizeof(*c->requestedLeftVelocity));
+
+	return c->bumpsWheelDrops && c->wall && c->cliffLeft && c->cliffFrontLeft
+		&& c->cliffFrontRight && c->cliffRight && c->virtualWall && c->overcurrents
+		&& c->irOpcode && c->buttons && c->distance && c->angle && c->chargingState
+		&& c->voltage && c->current && c->batteryTemperature && c->batteryCharge
+		&& c->batteryCapacity && c->wallSignal && c->cliffLeftSignal
+		&& c->cliffFrontLeftSignal && c->cliffFrontRightSignal && c->cliffRightSignal
+		&& c->oiMode && c->songNumber && c->songPlaying && c->requestedVelocity
+		&& c->requestedRadius && c->requestedRightVelocity && c->requestedLeftVelocity;
+}
+
+void irobotSensorGroup6ColumnsFree(irobotSensorGroup6Columns_t * const c){
+	free(c->offset);
+	free(c->bumpsWheelDrops);
+	free(c->wall);
+	free(c->cliffLeft);
+	free(c->cliffFrontLeft);
+	free(c->cliffFrontRight);
+	free(c->cliffRight);
+	free(c->virtualWall);
+	free(c->overcurrents);
+	free(c->irOpcode);
+	free(c->buttons);
+	free(c->distance);
+	free(c->angle);
+	free(c->chargingState);
+	free(c->voltage);
+	free(c->current);
+	free(c->batteryTemperature);
+	free(c->batteryCharge);
+	free(c->batteryCapacity);
+	free(c->wallSignal);
+	free(c->cliffLeftSignal);
+	free(c->cliffFrontLeftSignal);
+	free(c->cliffFrontRightSignal);
+	free(c->cliffRightSignal);
+	free(c->oiMode);
+	free(c->songNumber);
+	free(c->songPlaying);
+	free(c->requestedVelocity);
+	free(c->requestedRadius);
+	free(c->requestedRightVelocity);
+	free(c->requestedLeftVelocity);
+	memset(c, 0, sizeof(*c));
+}
+
+bool irobotCaptureParse(
+	const uint8_t * const					bytes,
+	const uint64_t							nBytes,
+	const uint32_t							nThreads,
+	irobotSensorGroup6Columns_t * const		pColumns,
+	irobotCaptureStatistics_t * const		pStatistics
+){
+	captureChunk_t	chunks[MAX_THREADS];
+	captureRange_t	ranges[MAX_THREADS];
+	pthread_t		threads[MAX_THREADS];
+	uint32_t		nChunks = nThreads;
+	uint64_t		nOffsets = 0;
+	uint32_t		k;
+	bool			success = true;
+
+	memset(pColumns, 0, sizeof(*pColumns));
+	memset(pStatistics, 0, sizeof(*pStatistics));
+	pStatistics->nBytes = nBytes;
+
+	if(nChunks == 0){
+		const long nProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+		nChunks = nProcessors > 0 ? (uint32_t)nProcessors : 1;
+	}
+	if(nChunks > MAX_THREADS){
+		nChunks = MAX_THREADS;
+	}
+	if(nChunks > nBytes / MIN_CHUNK_SIZE + 1){
+		nChunks = (uint32_t)(nBytes / MIN_CHUNK_SIZE + 1);
+	}
+	pStatistics->nThreads = nChunks;
+
+	// pass 1: find packets in each chunk
+	for(k = 0; k < nChunks; k++){
+		captureChunk_t * const pChunk = &chunks[k];
+
+		pChunk->bytes = bytes;
+		pChunk->nBytes = nBytes;
+		pChunk->start = nBytes * k / nChunks;
+		pChunk->end = nBytes * (k + 1) / nChunks;
+		pChunk->nOffsets = 0;
+		pChunk->resume = pChunk->end;
+		pChunk->offsets = malloc(((pChunk->end - pChunk->start) / CAPTURE_PACKET_SIZE + 1) * sizeof(*pChunk->offsets));
+		success = success && pChunk->offsets;
+	}
+	for(k = 0; success && k < nChunks; k++){
+		if(pthread_create(&threads[k], NULL, captureScanChunk, &chunks[k]) != 0){
+			captureScanChunk(&chunks[k]);
+			threads[k] = pthread_self();
+		}
+	}
+	for(k = 0; success && k < nChunks; k++){
+		if(!pthread_equal(threads[k], pthread_self())){
+			pthread_join(threads[k], NULL);
+		}
+	}
+
+	// merge the chunks, then decode in parallel
+	pColumns->offset = success ? malloc((nBytes / CAPTURE_PACKET_SIZE + 1) * sizeof(*pColumns->offset)) : NULL;
+	if(pColumns->offset){
+		nOffsets = captureMerge(bytes, nBytes, chunks, nChunks, pColumns->offset);
+		pColumns->nPackets = nOffsets;
+	}
+	for(k = 0; k < nChunks; k++){
+		free(chunks[k].offsets);
+	}
+	if(!pColumns->offset || !columnsAllocate(pColumns, pColumns->nPackets)){
+		irobotSensorGroup6ColumnsFree(pColumns);
+		return false;
+	}
+
+	// pass 2: decode
+	for(k = 0; k < nChunks; k++){
+		captureRange_t * const pRange = &ranges[k];
+
+		pRange->bytes = bytes;
+		pRange->pColumns = pColumns;
+		pRange->first = nOffsets * k / nChunks;
+		pRange->last = nOffsets * (k + 1) / nChunks;
+		if(pthread_create(&threads[k], NULL, captureDecodeRange, pRange) != 0){
+			captureDecodeRange(pRange);
+			threads[k] = pthread_self();
+		}
+	}
+	for(k = 0; k < nChunks; k++){
+		if(!pthread_equal(threads[k], pthread_self())){
+			pthread_join(threads[k], NULL);
+		}
+		pStatistics->nResyncs += ranges[k].nResyncs;
+	}
+
+	pStatistics->nPackets = nOffsets;
+	pStatistics->nBytesSkipped = nBytes - nOffsets * CAPTURE_PACKET_SIZE;
+	if(nOffsets > 0 && pColumns->offset[nOffsets - 1] + CAPTURE_PACKET_SIZE != nBytes){
+		pStatistics->nResyncs++;		// trailing bytes
+	}
+	else if(nOffsets == 0 && nBytes > 0){
+		pStatistics->nResyncs++;
+	}
+
+	return true;
+}
@@ -0,0 +1,94 @@
+/** \file irobotCaptureParser.h
+ *
+ * Offline parser for raw UART captures of the sensor stream sent by the
+ * iRobot Create: a sequence of Group 6 stream packets,
+ *
+ *	[19] [53] [6] [52 bytes of sensor data] [checksum]
+ *
+ * interleaved with whatever corrupt or unrelated bytes the capture picked
+ * up. The capture is split into chunks that are scanned for packets in
+ * parallel, and the packets are decoded, again in parallel, into one
+ * column per sensor. The result is the same as one serial pass that
+ * resynchronizes byte by byte after a bad header or checksum.
+ */
+
+#ifndef IROBOTCAPTUREPARSER_H_
+#define IROBOTCAPTUREPARSER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define CAPTURE_STREAM_HEADER		19		///< first byte of a stream packet
+#define CAPTURE_GROUP6_ID			6		///< sensor packet id of group 6
+#define CAPTURE_GROUP6_SIZE			52		///< sensor data in a group 6 packet, in bytes
+#define CAPTURE_PACKET_SIZE			(CAPTURE_GROUP6_SIZE + 4)	///< header, size, packet id, data, checksum
+
+/// Group 6 sensors, one column per sensor; row i is the i-th packet in the capture
+typedef struct{
+	size_t		nPackets;					///< number of rows
+	uint64_t *	offset;						///< offset of the packet in the capture, in bytes
+	uint8_t *	bumpsWheelDrops;			///< packet 7: bumps and wheel drops, bitmask
+	uint8_t *	wall;						///< packet 8
+	uint8_t *	cliffLeft;					///< packet 9
+	uint8_t *	cliffFrontLeft;				///< packet 10
+	uint8_t *	cliffFrontRight;			///< packet 11
+	uint8_t *	cliffRight;					///< packet 12
+	uint8_t *	virtualWall;				///< packet 13
+	uint8_t *	overcurrents;				///< packet 14: low side drivers and wheel overcurrents, bitmask
+	uint8_t *	irOpcode;					///< packet 17
+	uint8_t *	buttons;					///< packet 18: play and advance, bitmask
+	int16_t *	distance;					///< packet 19: distance since the previous packet, in mm
+	int16_t *	angle;						///< packet 20: angle since the previous packet, in deg
+	uint8_t *	chargingState;				///< packet 21
+	uint16_t *	voltage;					///< packet 22: battery voltage, in mV
+	int16_t *	current;					///< packet 23: battery current, in mA
+	int8_t *	batteryTemperature;			///< packet 24: in C
+	uint16_t *	batteryCharge;				///< packet 25: in mAh
+	uint16_t *	batteryCapacity;			///< packet 26: in mAh
+	uint16_t *	wallSignal;					///< packet 27
+	uint16_t *	cliffLeftSignal;			///< packet 28
+	uint16_t *	cliffFrontLeftSignal;		///< packet 29
+	uint16_t *	cliffFrontRightSignal;		///< packet 30
+	uint16_t *	cliffRightSignal;			///< packet 31
+	uint8_t *	oiMode;						///< packet 35: 0 off, 1 passive, 2 safe, 3 full
+	uint8_t *	songNumber;					///< packet 36
+	uint8_t *	songPlaying;				///< packet 37
+	int16_t *	requestedVelocity;			///< packet 39: in mm/s
+	int16_t *	requestedRadius;			///< packet 40: in mm
+	int16_t *	requestedRightVelocity;		///< packet 41: in mm/s
+	int16_t *	requestedLeftVelocity;		///< packet 42: in mm/s
+} irobotSensorGroup6Columns_t;
+
+/// Capture statistics
+typedef struct{
+	uint64_t	nBytes;						///< bytes in the capture
+	uint64_t	nPackets;					///< valid packets found
+	uint64_t	nBytesSkipped;				///< bytes outside valid packets
+	uint64_t	nResyncs;					///< runs of skipped bytes; each one is a loss of synchronization
+	uint32_t	nThreads;					///< threads used
+} irobotCaptureStatistics_t;
+
+/// \returns true if a valid group 6 stream packet starts at offset
+bool irobotCaptureIsPacket(
+	const uint8_t * const		bytes,		///< [in] capture
+	const uint64_t				nBytes,		///< [in] size of the capture, in bytes
+	const uint64_t				offset		///< [in] candidate packet offset
+);
+
+/// Find and decode every group 6 packet in a capture.
+/// \returns false if the columns could not be allocated
+bool irobotCaptureParse(
+	const uint8_t * const					bytes,		///< [in] capture
+	const uint64_t							nBytes,		///< [in] size of the capture, in bytes
+	const uint32_t							nThreads,	///< [in] threads to use; 0 for one per processor
+	irobotSensorGroup6Columns_t * const		pColumns,	///< [out] decoded sensors; free with irobotSensorGroup6ColumnsFree()
+	irobotCaptureStatistics_t * const		pStatistics	///< [out] statistics
+);
+
+/// Free the columns allocated by irobotCaptureParse().
+void irobotSensorGroup6ColumnsFree(
+	irobotSensorGroup6Columns_t * const		pColumns	///< [in,out] columns
+);
+
+#endif // IROBOTCAPTUREPARSER_H_
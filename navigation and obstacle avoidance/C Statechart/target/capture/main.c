@@ -0,0 +1,289 @@
+/** \file main.c
+ *
+ * Analyzes a raw UART capture of the sensor stream sent by the iRobot
+ * Create, such as the bytes read by a serial tap on the myRIO UART, or the
+ * capture written by the standin target. The capture is memory-mapped and
+ * parsed in parallel by irobotCaptureParser.c; statistics and a summary are
+ * printed, and the decoded columns can be written as CSV.
+ *
+ * Build (Linux), from this directory:
+ *	gcc -O2 -o capture main.c irobotCaptureParser.c -lpthread
+ *
+ * Usage:
+ *	capture [-j threads] [-s] [-o columns.csv] <capture file>
+ *	capture -g packets [-e corrupt one in N] <capture file>
+ *
+ * -s also parses the capture with a single thread and checks that both
+ * parses found the same packets. -g writes a synthetic capture instead, with
+ * garbage bytes and corrupt packets, for measuring the parser.
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "irobotCaptureParser.h"
+
+static const uint32_t defaultCorruptOneIn = 1000;	// packets per corrupt packet or garbage run in a synthetic capture
+
+static uint64_t randomState = 0x2545F4914F6CDD1DULL;
+
+/// xorshift64; deterministic so that synthetic captures are reproducible
+static uint32_t randomNext(void){
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 7;
+	randomState ^= randomState << 17;
+	return (uint32_t)(randomState >> 32);
+}
+
+static double clockSeconds(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void putInt16(uint8_t * const bytes, const int32_t value){
+	bytes[0] = (uint8_t)((uint16_t)value >> 8);
+	bytes[1] = (uint8_t)value;
+}
+
+/// Write a synthetic capture: a robot driving and turning, with garbage
+/// between some packets and corrupt bytes in others.
+/// \returns false on a write error
+static bool captureGenerate(const char * const path, const uint64_t nPackets, const uint32_t corruptOneIn){
+	FILE *		file = fopen(path, "wb");
+	uint8_t		packet[CAPTURE_PACKET_SIZE];
+	uint64_t	i;
+
+	if(!file){
+		perror("capture: fopen");
+		return false;
+	}
+	setvbuf(file, NULL, _IOFBF, 1 << 20);
+
+	for(i = 0; i < nPackets; i++){
+		uint8_t * const	data = &packet[3];
+		uint8_t			checksum = 0;
+		uint32_t		j;
+
+		packet[0] = CAPTURE_STREAM_HEADER;
+		packet[1] = CAPTURE_GROUP6_SIZE + 1;
+		packet[2] = CAPTURE_GROUP6_ID;
+		for(j = 0; j < CAPTURE_GROUP6_SIZE; j++){
+			data[j] = (uint8_t)randomNext();		// signals and unused packets
+		}
+		data[0] = randomNext() % 64 == 0 ? (uint8_t)(1 + randomNext() % 3) : 0;
+		data[1] = data[0] != 0;
+		memset(&data[2], 0, 5);
+		data[11] = 0;
+		putInt16(&data[12], 6 + (int32_t)(randomNext() % 3));
+		putInt16(&data[14], (int32_t)(randomNext() % 3) - 1);
+		putInt16(&data[17], 16000 - (int32_t)(i / 100000));
+		data[40] = 2;
+		for(j = 0; j < CAPTURE_PACKET_SIZE - 1; j++){
+			checksum += packet[j];
+		}
+		packet[CAPTURE_PACKET_SIZE - 1] = (uint8_t)(0x100 - checksum);
+
+		if(corruptOneIn > 0 && randomNext() % corruptOneIn == 0){
+			if(randomNext() % 2){
+				packet[randomNext() % CAPTURE_PACKET_SIZE] ^= (uint8_t)(1 + randomNext() % 255);
+			}
+			else{
+				uint8_t		garbage[64];
+				uint32_t	nGarbage = 1 + randomNext() % sizeof(garbage);
+
+				for(j = 0; j < nGarbage; j++){
+					garbage[j] = randomNext() % 4 == 0 ? CAPTURE_STREAM_HEADER : (uint8_t)randomNext();
+				}
+				fwrite(garbage, 1, nGarbage, file);
+			}
+		}
+		fwrite(packet, 1, sizeof(packet), file);
+	}
+
+	if(fclose(file) != 0){
+		perror("capture: fclose");
+		return false;
+	}
+	return true;
+}
+
+/// Write the columns as CSV, one row per packet.
+static bool columnsWriteCsv(const char * const path, const irobotSensorGroup6Columns_t * const c){
+	FILE *	file = fopen(path, "w");
+	size_t	i;
+
+	if(!file){
+		perror("capture: fopen");
+		return false;
+	}
+	setvbuf(file, NULL, _IOFBF, 1 << 20);
+
+	fprintf(file, "offset,bumpsWheelDrops,wall,cliffLeft,cliffFrontLeft,cliffFrontRight,cliffRight,"
+		"virtualWall,overcurrents,irOpcode,buttons,distance,angle,chargingState,voltage,current,"
+		"batteryTemperature,batteryCharge,batteryCapacity,wallSignal,cliffLeftSignal,"
+		"cliffFrontLeftSignal,cliffFrontRightSignal,cliffRightSignal,oiMode,songNumber,songPlaying,"
+		"requestedVelocity,requestedRadius,requestedRightVelocity,requestedLeftVelocity\n");
+	for(i = 0; i < c->nPackets; i++){
+		fprintf(file, "%llu,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%d,%d,%u,%u,%d,%d,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%d,%d,%d,%d\n",
+			(unsigned long long)c->offset[i], c->bumpsWheelDrops[i], c->wall[i], c->cliffLeft[i],
+			c->cliffFrontLeft[i], c->cliffFrontRight[i], c->cliffRight[i], c->virtualWall[i],
+			c->overcurrents[i], c->irOpcode[i], c->buttons[i], c->distance[i], c->angle[i],
+			c->chargingState[i], c->voltage[i], c->current[i], c->batteryTemperature[i],
+			c->batteryCharge[i], c->batteryCapacity[i], c->wallSignal[i], c->cliffLeftSignal[i],
+			c->cliffFrontLeftSignal[i], c->cliffFrontRightSignal[i], c->cliffRightSignal[i],
+			c->oiMode[i], c->songNumber[i], c->songPlaying[i], c->requestedVelocity[i],
+			c->requestedRadius[i], c->requestedRightVelocity[i], c->requestedLeftVelocity[i]);
+	}
+
+	if(fclose(file) != 0){
+		perror("capture: fclose");
+		return false;
+	}
+	return true;
+}
+
+/// Print what a field debugging session usually wants first.
+static void columnsPrintSummary(const irobotSensorGroup6Columns_t * const c){
+	int64_t		netDistance = 0;
+	int64_t		netAngle = 0;
+	uint64_t	nBumps = 0;
+	uint64_t	nCliffs = 0;
+	uint16_t	minVoltage = UINT16_MAX;
+	uint16_t	maxVoltage = 0;
+	size_t		i;
+
+	// column loops; each touches only the columns it needs
+	for(i = 0; i < c->nPackets; i++){
+		netDistance += c->distance[i];
+	}
+	for(i = 0; i < c->nPackets; i++){
+		netAngle += c->angle[i];
+	}
+	for(i = 0; i < c->nPackets; i++){
+		nBumps += (c->bumpsWheelDrops[i] & 0x03) != 0;
+	}
+	for(i = 0; i < c->nPackets; i++){
+		nCliffs += (c->cliffLeft[i] | c->cliffFrontLeft[i] | c->cliffFrontRight[i] | c->cliffRight[i]) != 0;
+	}
+	for(i = 0; i < c->nPackets; i++){
+		minVoltage = c->voltage[i] < minVoltage ? c->voltage[i] : minVoltage;
+		maxVoltage = c->voltage[i] > maxVoltage ? c->voltage[i] : maxVoltage;
+	}
+
+	printf("net distance %lld mm, net angle %lld deg\n", (long long)netDistance, (long long)netAngle);
+	printf("%llu packets with a bump, %llu with a cliff\n", (unsigned long long)nBumps, (unsigned long long)nCliffs);
+	if(c->nPackets > 0){
+		printf("battery %u to %u mV\n", minVoltage, maxVoltage);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	irobotSensorGroup6Columns_t	columns;
+	irobotCaptureStatistics_t	statistics;
+	const char *				csvPath = NULL;
+	const uint8_t *				bytes;
+	struct stat					fileStat;
+	uint64_t					nGenerate = 0;
+	uint32_t					corruptOneIn = defaultCorruptOneIn;
+	uint32_t					nThreads = 0;
+	bool						checkSerial = false;
+	double						seconds;
+	int							option;
+	int							fd;
+
+	while((option = getopt(argc, argv, "j:so:g:e:")) != -1){
+		switch(option){
+		case 'j': nThreads = (uint32_t)strtoul(optarg, NULL, 10); break;
+		case 's': checkSerial = true; break;
+		case 'o': csvPath = optarg; break;
+		case 'g': nGenerate = strtoull(optarg, NULL, 10); break;
+		case 'e': corruptOneIn = (uint32_t)strtoul(optarg, NULL, 10); break;
+		default:
+			fprintf(stderr, "Usage: %s [-j threads] [-s] [-o columns.csv] <capture file>\n"
+							"       %s -g packets [-e corrupt one in N] <capture file>\n", argv[0], argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if(optind >= argc){
+		fprintf(stderr, "%s: no capture file\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if(nGenerate > 0){
+		return captureGenerate(argv[optind], nGenerate, corruptOneIn) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// map the capture; the parser reads it at most twice, front to back
+	fd = open(argv[optind], O_RDONLY);
+	if(fd < 0 || fstat(fd, &fileStat) != 0){
+		perror("capture: open");
+		return EXIT_FAILURE;
+	}
+	if(fileStat.st_size == 0){
+		bytes = NULL;
+	}
+	else{
+		bytes = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+		if(bytes == MAP_FAILED){
+			perror("capture: mmap");
+			return EXIT_FAILURE;
+		}
+		madvise((void *)bytes, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+	}
+
+	seconds = clockSeconds();
+	if(!irobotCaptureParse(bytes, (uint64_t)fileStat.st_size, nThreads, &columns, &statistics)){
+		fprintf(stderr, "capture: out of memory\n");
+		return EXIT_FAILURE;
+	}
+	seconds = clockSeconds() - seconds;
+
+	printf("%llu bytes, %llu packets, %llu bytes skipped in %llu resyncs\n",
+		(unsigned long long)statistics.nBytes,
+		(unsigned long long)statistics.nPackets,
+		(unsigned long long)statistics.nBytesSkipped,
+		(unsigned long long)statistics.nResyncs);
+	printf("parsed in %.3f s on %u threads, %.0f MB/s\n",
+		seconds, statistics.nThreads, seconds > 0 ? (double)statistics.nBytes / seconds / 1e6 : 0.0);
+	columnsPrintSummary(&columns);
+
+	if(checkSerial){
+		irobotSensorGroup6Columns_t	serialColumns;
+		irobotCaptureStatistics_t	serialStatistics;
+		bool						same;
+
+		seconds = clockSeconds();
+		if(!irobotCaptureParse(bytes, (uint64_t)fileStat.st_size, 1, &serialColumns, &serialStatistics)){
+			fprintf(stderr, "capture: out of memory\n");
+			return EXIT_FAILURE;
+		}
+		seconds = clockSeconds() - seconds;
+		same = serialColumns.nPackets == columns.nPackets
+			&& memcmp(serialColumns.offset, columns.offset, columns.nPackets * sizeof(*columns.offset)) == 0;
+		printf("serial parse in %.3f s: %s\n", seconds, same ? "same packets" : "DIFFERENT packets");
+		irobotSensorGroup6ColumnsFree(&serialColumns);
+		if(!same){
+			return EXIT_FAILURE;
+		}
+	}
+
+	if(csvPath && !columnsWriteCsv(csvPath, &columns)){
+		return EXIT_FAILURE;
+	}
+
+	irobotSensorGroup6ColumnsFree(&columns);
+	if(bytes){
+		munmap((void *)bytes, (size_t)fileStat.st_size);
+	}
+	close(fd);
+
+	return EXIT_SUCCESS;
+}
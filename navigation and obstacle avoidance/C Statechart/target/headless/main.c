@@ -0,0 +1,457 @@
+/** \file main.c
+ *
+ * Runs the control loop of irobotApp.c headless, against the stand-in
+ * iRobot Create, on a virtual clock. Delays advance the clock instead of
+ * sleeping, and every UART byte is charged the time it takes on the wire,
+ * so the loop sees the same timing as on the myRIO while running as fast
+ * as the host allows. Use it for soak tests of the statechart that would
+ * take hours in real time.
+ *
+ * Build (Linux), from this directory:
+ *	gcc -O2 -I../.. -I../../.. -I../../../irobot -I../standin -o headless main.c
+ *		../standin/irobotCreateStandIn.c ../standin/irobotWorld.c ../../irobotApp.c ../../irobotActuation.c ../../irobotScript.c
+ *		../../accelerometerFilter.c ../../irobotMission.c ../../irobotStatechartCoverage.c
+ *		../../irobotSharedMap.c ../../irobotNavigationStatechart.c
+ *		../../../irobot/irobotSensorStream.c ../../../irobot/xqueue.c ... -lm
+ *
+ * To run any variant, define IROBOT_STATECHART_VARIANTS and link all of
+ * them with ../../irobotStatechartVariants.c, as for the benchmark target.
+ *
+ * Usage:
+ *	headless [-t virtual seconds] [-r room size, in mm] [-v] [-n robots] [-m map.pgm]
+ *		[-w world pack [-i world]] [-s script segment, in ms] [-p loop period, in ms] [statechart variant]
+ *
+ * Play is pressed half a second into the run; the run ends after the
+ * virtual time, default one hour, or when the statechart stops on advance.
+ *
+ * With -w, the room is a world from a pack written by the worldgen target,
+ * and the accelerometer follows its ramps; -i picks the world.
+ *
+ * With -s, maneuvers that end at a known distance or angle run on the
+ * stand-in as scripts, in segments of about the given duration
+ * (irobotScript.h), and the sensors are read only between segments.
+ *
+ * With -p, the loop runs at the given period whatever the statechart asks
+ * for, to compare the adaptive period with a fixed one; the stand-in
+ * reports how long the statechart takes to react to each obstacle.
+ *
+ * With -n, several robots explore the room at once, each in its own
+ * process with its own stand-in; they do not see each other. Their bump,
+ * wall and cliff events go into one irobotSharedMap.h map in shared
+ * memory, which -m writes as an image.
+ */
+
+#define _GNU_SOURCE
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "irobotApp.h"
+#include "irobotHal.h"
+#include "irobotCreateStandIn.h"
+#include "irobotOpenInterface.h"
+#include "irobotSensorStream.h"
+#include "irobotSharedMap.h"
+#ifdef IROBOT_STATECHART_VARIANTS
+	#include "irobotStatechartVariants.h"
+#endif
+
+#define SENSOR_GROUP6_ID	6		///< packet id of sensor group 6
+
+static const uint64_t	usPerUartByte = 10 * 1000000 / 57600;	// start, 8 data and stop bits at 57600 baud, in us
+static const uint64_t	playPressMs = 500;						// virtual time at which play is pressed, in ms
+static const uint64_t	buttonPressMs = 200;					// how long a button is held down, in ms
+static const double		defaultRoomSize = 4000;					// side of the room, in mm
+static const double		defaultSeconds = 3600;					// virtual run time, in s
+static const double		accelNoise = 0.01;						// accelerometer noise amplitude, in g
+static const double		mapCellSize = 25;						// side of a cell of the shared map, in mm
+static const uint64_t	sensorTimeoutMs = 1000;					// longest wait for the reply to a sensor query, in ms
+
+const double alpha = 0.2;				// accelerometer filter coefficient, at the nominal loop period
+const uint32_t maxAcceleration = 1000;	// largest wheel acceleration, in mm/s^2
+const uint32_t driveRefreshMs = 1000;	// interval to resend an unchanged drive command, in ms
+
+/// Simulated hardware behind the HAL
+typedef struct{
+	irobotCreateStandIn_t	create;			///< robot on the other end of the UART
+	uint64_t				usNow;			///< virtual clock, in us
+	uint64_t				msModel;		///< virtual time the stand-in has been advanced to, in ms
+	uint64_t				nUartBytes;		///< bytes sent and received on the UART
+	uint64_t				randomState;	///< accelerometer noise generator
+	irobotSharedMap_t *		pMap;			///< map of the sensor events of every robot
+} headless_t;
+
+static uint64_t getWallTimeInNs(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+/// Advance the virtual clock, and the stand-in with it.
+static void headlessAdvance(headless_t * const pHeadless, const uint64_t us){
+	uint64_t msNow;
+
+	pHeadless->usNow += us;
+	msNow = pHeadless->usNow / 1000;
+	if(msNow > pHeadless->msModel){
+		pHeadless->create.buttonPlay = msNow >= playPressMs && msNow < playPressMs + buttonPressMs;
+		irobotCreateStandInAdvance(&pHeadless->create, (uint32_t)(msNow - pHeadless->msModel));
+		pHeadless->msModel = msNow;
+	}
+}
+
+/// Charge UART bytes to the virtual clock.
+static void headlessUart(headless_t * const pHeadless, const size_t nBytes){
+	pHeadless->nUartBytes += nBytes;
+	headlessAdvance(pHeadless, nBytes * usPerUartByte);
+}
+
+static uint64_t headlessTimeMs(void * const pContext){
+	return ((headless_t*)pContext)->usNow / 1000;
+}
+
+static void headlessDelayMs(void * const pContext, const uint64_t ms){
+	headlessAdvance((headless_t*)pContext, ms * 1000);
+}
+
+/// Query sensor group 6 and decode the reply as the sensor stream would be.
+static int32_t headlessReadSensors(void * const pContext, irobotSensorGroup6_t * const pSensors){
+	static const uint8_t	query[2] = {OI_SENSORS, SENSOR_GROUP6_ID};
+	headless_t * const		pHeadless = (headless_t*)pContext;
+	uint8_t					packet[SENSOR_GROUP6_SIZE + 4];
+	uint8_t					queueBuffer[SENSOR_SIZE_UPPER_BOUND];
+	xqueue_t				queue;
+	bool					packetFound = false;
+	uint8_t					checksum = 0;
+	size_t					nReply;
+	size_t					i;
+	int32_t					status;
+
+	irobotCreateStandInReceive(&pHeadless->create, query, sizeof(query));
+	headlessUart(pHeadless, sizeof(query));
+	nReply = irobotCreateStandInTakeReply(&pHeadless->create, &packet[3], SENSOR_GROUP6_SIZE);
+	headlessUart(pHeadless, nReply);
+
+	// a playing script holds the query; wait for the reply as a UART read with a timeout would
+	for(i = 0; nReply < SENSOR_GROUP6_SIZE && i < sensorTimeoutMs; i++){
+		size_t nBytes;
+
+		headlessAdvance(pHeadless, 1000);
+		nBytes = irobotCreateStandInTakeReply(&pHeadless->create, &packet[3 + nReply], SENSOR_GROUP6_SIZE - nReply);
+		headlessUart(pHeadless, nBytes);
+		nReply += nBytes;
+	}
+	if(nReply != SENSOR_GROUP6_SIZE){
+		return ERROR_INVALID_PARAMETER;
+	}
+
+	// frame the reply as a stream packet: header, size, id, data, checksum
+	packet[0] = 19;
+	packet[1] = SENSOR_GROUP6_SIZE + 1;
+	packet[2] = SENSOR_GROUP6_ID;
+	for(i = 0; i < SENSOR_GROUP6_SIZE + 3; i++){
+		checksum += packet[i];
+	}
+	packet[SENSOR_GROUP6_SIZE + 3] = (uint8_t)(0x100 - checksum);
+
+	xqueue_init(&queue, queueBuffer, SENSOR_SIZE_UPPER_BOUND);
+	xqueue_push_buffer(&queue, packet, sizeof(packet));
+	status = irobotSensorStreamProcessAll(&queue, pSensors, &packetFound);
+	if(status < 0 || !packetFound){
+		return status < 0 ? status : ERROR_INVALID_PARAMETER;
+	}
+
+	// the simulation knows the true pose, so events are mapped where they happened
+	irobotSharedMapRecord(pHeadless->pMap, pHeadless->create.x, pHeadless->create.y, pHeadless->create.heading, pSensors);
+	return status;
+}
+
+static int32_t headlessDriveDirect(void * const pContext, const int16_t leftWheelSpeed, const int16_t rightWheelSpeed){
+	headless_t * const	pHeadless = (headless_t*)pContext;
+	const uint8_t		command[5] = {
+		OI_DRIVE_DIRECT,
+		(uint8_t)((uint16_t)rightWheelSpeed >> 8), (uint8_t)rightWheelSpeed,
+		(uint8_t)((uint16_t)leftWheelSpeed >> 8), (uint8_t)leftWheelSpeed,
+	};
+
+	irobotCreateStandInReceive(&pHeadless->create, command, sizeof(command));
+	headlessUart(pHeadless, sizeof(command));
+	return ERROR_SUCCESS;
+}
+
+static int32_t headlessUploadScript(void * const pContext, const uint8_t * const script, const uint8_t size){
+	headless_t * const	pHeadless = (headless_t*)pContext;
+	const uint8_t		header[2] = {OI_SCRIPT, size};
+
+	irobotCreateStandInReceive(&pHeadless->create, header, sizeof(header));
+	irobotCreateStandInReceive(&pHeadless->create, script, size);
+	headlessUart(pHeadless, sizeof(header) + size);
+	return ERROR_SUCCESS;
+}
+
+static int32_t headlessPlayScript(void * const pContext){
+	headless_t * const	pHeadless = (headless_t*)pContext;
+	const uint8_t		command = OI_PLAY_SCRIPT;
+
+	irobotCreateStandInReceive(&pHeadless->create, &command, 1);
+	headlessUart(pHeadless, 1);
+	return ERROR_SUCCESS;
+}
+
+/// Uniform noise in [-1, 1); xorshift64, so that runs are reproducible.
+static double headlessNoise(headless_t * const pHeadless){
+	pHeadless->randomState ^= pHeadless->randomState << 13;
+	pHeadless->randomState ^= pHeadless->randomState >> 7;
+	pHeadless->randomState ^= pHeadless->randomState << 17;
+	return (double)(pHeadless->randomState >> 11) / (double)(1ULL << 52) - 1;
+}
+
+/// Gravity in the robot frame, x forward and y left, with sensor noise.
+static int32_t headlessReadAccelerometer(void * const pContext, accelerometer_t * const pAccel){
+	headless_t * const			pHeadless = (headless_t*)pContext;
+	const irobotCreateStandIn_t * const	pCreate = &pHeadless->create;
+	const irobotWorldRamp_t *	pRamp = pCreate->pWorld ? irobotWorldRampAt(pCreate->pWorld, pCreate->x, pCreate->y) : NULL;
+	double						slope = 0;
+	double						bearing = 0;
+
+	if(pRamp){
+		// on a ramp, the accelerometer tips toward the uphill direction
+		slope = pRamp->inclination * M_PI / 180;
+		bearing = pRamp->uphill - pCreate->heading;
+	}
+	pAccel->x = sin(slope) * cos(bearing) + accelNoise * headlessNoise(pHeadless);
+	pAccel->y = sin(slope) * sin(bearing) + accelNoise * headlessNoise(pHeadless);
+	pAccel->z = cos(slope) + accelNoise * headlessNoise(pHeadless);
+	return ERROR_SUCCESS;
+}
+
+/// Run one robot from its own place in the room, and print its statistics.
+/// \returns status of the control loop
+static int32_t headlessRobot(
+	const uint32_t						robot,		///< [in] robot number
+	const uint32_t						nRobots,	///< [in] number of robots in the room
+	const double						roomSize,	///< [in] side of the room, in mm
+	const irobotWorld_t * const			pWorld,		///< [in] world, or NULL for an empty room
+	irobotNavigationStatechart_t		statechart,	///< [in] statechart to execute
+	const irobotAppConfig_t * const		pConfig,	///< [in] control loop configuration
+	irobotSharedMap_t * const			pMap		///< [in,out] map shared by every robot
+){
+	static headless_t		headless;
+	const irobotHal_t		hal = {
+		.pContext = &headless,
+		.timeMs = headlessTimeMs,
+		.delayMs = headlessDelayMs,
+		.readSensors = headlessReadSensors,
+		.driveDirect = headlessDriveDirect,
+		.readAccelerometer = headlessReadAccelerometer,
+		.uploadScript = headlessUploadScript,
+		.playScript = headlessPlayScript,
+	};
+	irobotAppStatistics_t	statistics;
+	uint64_t				nsStart;
+	double					wallSeconds;
+	int32_t					status;
+
+	irobotCreateStandInInit(&headless.create, roomSize);
+	headless.randomState = 0x2545F4914F6CDD1DULL + robot;
+	headless.pMap = pMap;
+	if(pWorld){
+		// the start is the only place known to be clear; the robots leave it in different directions
+		irobotCreateStandInSetWorld(&headless.create, pWorld);
+		headless.create.heading += 2 * M_PI * robot / nRobots;
+	}
+	else if(nRobots > 1){
+		// spread the robots on a circle, facing outward
+		headless.create.heading = 2 * M_PI * robot / nRobots;
+		headless.create.x = roomSize / 4 * cos(headless.create.heading);
+		headless.create.y = roomSize / 4 * sin(headless.create.heading);
+	}
+
+	nsStart = getWallTimeInNs();
+	status = irobotAppRun(&hal, statechart, pConfig, &statistics);
+	wallSeconds = (getWallTimeInNs() - nsStart) / 1e9;
+
+	if(nRobots > 1){
+		printf("\nrobot %u\n", robot);
+	}
+	irobotAppPrintStatistics(&statistics);
+	irobotCreateStandInPrintStatistics(&headless.create);
+	printf("UART busy %.1f%% of virtual time\n",
+			statistics.elapsedMs ? 100.0 * headless.nUartBytes * usPerUartByte / (statistics.elapsedMs * 1000.0) : 0);
+	printf("final position x=%.0f y=%.0f mm, heading %.0f deg%s\n",
+			headless.create.x,
+			headless.create.y,
+			fmod(headless.create.heading * 180 / M_PI, 360),
+			headless.create.wheelDrop ? ", fell over a cliff" : "");
+	printf("%.1f s virtual in %.3f s wall, %.0fx real time\n",
+			statistics.elapsedMs / 1000.0,
+			wallSeconds,
+			wallSeconds > 0 ? statistics.elapsedMs / 1000.0 / wallSeconds : 0);
+	if(status < 0){
+		fprintf(stderr, "headless: robot %u stopped with status %d\n", robot, status);
+	}
+	fflush(stdout);
+	return status;
+}
+
+/// Write the map as a PGM image: unknown grey, visited white, events black.
+static bool headlessWriteMap(const irobotSharedMap_t * const pMap, const char * const path){
+	const double	cellSize = 1 / pMap->cellsPerMm;
+	FILE * const	file = fopen(path, "wb");
+	uint32_t		row;
+	uint32_t		column;
+
+	if(!file){
+		perror("headless: fopen");
+		return false;
+	}
+	fprintf(file, "P5\n%u %u\n255\n", pMap->cellsPerSide, pMap->cellsPerSide);
+	for(row = pMap->cellsPerSide; row-- > 0;){
+		for(column = 0; column < pMap->cellsPerSide; column++){
+			const uint8_t flags = irobotSharedMapRead(pMap,
+													  pMap->originX + (column + 0.5) * cellSize,
+													  pMap->originY + (row + 0.5) * cellSize);
+
+			fputc(flags & (SHARED_MAP_OBSTACLE | SHARED_MAP_WALL | SHARED_MAP_CLIFF) ? 0 : flags & SHARED_MAP_VISITED ? 255 : 160, file);
+		}
+	}
+	return fclose(file) == 0;
+}
+
+int main(int argc, char **argv)
+{
+	irobotAppConfig_t		config = {
+		.alpha = alpha,
+		.maxAcceleration = maxAcceleration,
+		.driveRefreshMs = driveRefreshMs,
+		.isSimulator = true,
+		.verbose = false,
+		.maneuver = irobotNavigationStatechartManeuver,
+	};
+	irobotNavigationStatechart_t	statechart = irobotNavigationStatechart;
+	double					roomSize = defaultRoomSize;
+	double					seconds = defaultSeconds;
+	uint32_t				nRobots = 1;
+	const char *			mapPath = NULL;
+	const char *			worldPath = NULL;
+	uint32_t				worldIndex = 0;
+	irobotWorldPack_t		pack;
+	irobotWorld_t			world;
+	const irobotWorld_t *	pWorld = NULL;
+	irobotSharedMap_t *		pMap;
+	size_t					mapSize;
+	void *					pMemory;
+	bool					failed = false;
+	uint32_t				robot;
+	int						option;
+
+	while((option = getopt(argc, argv, "t:r:vn:m:w:i:s:p:")) != -1){
+		switch(option){
+		case 't': seconds = atof(optarg); break;
+		case 'r': roomSize = atof(optarg); break;
+		case 'v': config.verbose = true; break;
+		case 'n': nRobots = (uint32_t)strtoul(optarg, NULL, 10); break;
+		case 'm': mapPath = optarg; break;
+		case 'w': worldPath = optarg; break;
+		case 'i': worldIndex = (uint32_t)strtoul(optarg, NULL, 10); break;
+		case 's': config.scriptSegmentMs = (uint32_t)strtoul(optarg, NULL, 10); break;
+		case 'p': config.fixedPeriodMs = (uint32_t)strtoul(optarg, NULL, 10); break;
+		default:
+			fprintf(stderr, "Usage: %s [-t virtual seconds] [-r room size, in mm] [-v] [-n robots] [-m map.pgm] [-w world pack [-i world]] [-s script segment, in ms] [-p loop period, in ms] [statechart variant]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if(nRobots == 0){
+		nRobots = 1;
+	}
+
+#ifdef IROBOT_STATECHART_VARIANTS
+	if(optind < argc){
+		const irobotStatechartVariant_t * const pVariant = irobotStatechartVariantFind(argv[optind]);
+		size_t iVariant;
+
+		if(!pVariant){
+			fprintf(stderr, "Variants:");
+			for(iVariant = 0; iVariant < irobotStatechartVariantCount; iVariant++){
+				fprintf(stderr, " %s", irobotStatechartVariants[iVariant].name);
+			}
+			fprintf(stderr, "\n");
+			return EXIT_FAILURE;
+		}
+		printf("statechart %s\n", pVariant->name);
+		statechart = pVariant->statechart;
+		config.maneuver = pVariant->maneuver;
+	}
+#endif
+
+	config.durationMs = (uint64_t)(seconds * 1000);
+
+	if(worldPath){
+		if(!irobotWorldPackOpen(&pack, worldPath)){
+			return EXIT_FAILURE;
+		}
+		if(!irobotWorldPackGet(&pack, worldIndex, &world)){
+			fprintf(stderr, "headless: %s has no world %u\n", worldPath, worldIndex);
+			return EXIT_FAILURE;
+		}
+		printf("world %u: %s, seed %u\n", worldIndex, irobotWorldKindName(world.pHeader->kind), world.pHeader->seed);
+		pWorld = &world;
+		roomSize = world.pHeader->roomSize;
+	}
+
+	// the map is shared with the robot processes
+	mapSize = irobotSharedMapSize(roomSize, mapCellSize);
+	pMemory = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if(pMemory == MAP_FAILED){
+		perror("headless: mmap");
+		return EXIT_FAILURE;
+	}
+	pMap = irobotSharedMapInit(pMemory, roomSize, mapCellSize);
+	fflush(stdout);
+
+	if(nRobots == 1){
+		failed = headlessRobot(0, 1, roomSize, pWorld, statechart, &config, pMap) < 0;
+	}
+	else{
+		// the statecharts keep their state in statics, so each robot is a process
+		for(robot = 0; robot < nRobots; robot++){
+			const pid_t pid = fork();
+
+			if(pid == 0){
+				_exit(headlessRobot(robot, nRobots, roomSize, pWorld, statechart, &config, pMap) < 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+			}
+			else if(pid < 0){
+				perror("headless: fork");
+				failed = true;
+				break;
+			}
+		}
+		for(;;){
+			int status;
+
+			if(wait(&status) < 0){
+				break;
+			}
+			failed |= !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS;
+		}
+	}
+
+	printf("\nmap: %u cells visited, %u obstacle, %u wall, %u cliff\n",
+			irobotSharedMapCount(pMap, SHARED_MAP_VISITED),
+			irobotSharedMapCount(pMap, SHARED_MAP_OBSTACLE),
+			irobotSharedMapCount(pMap, SHARED_MAP_WALL),
+			irobotSharedMapCount(pMap, SHARED_MAP_CLIFF));
+	if(mapPath && !headlessWriteMap(pMap, mapPath)){
+		failed = true;
+	}
+	munmap(pMemory, mapSize);
+	if(pWorld){
+		irobotWorldPackClose(&pack);
+	}
+
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
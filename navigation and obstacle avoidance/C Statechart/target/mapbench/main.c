@@ -0,0 +1,329 @@
+/** \file main.c
+ *
+ * Throughput of irobotSharedMap.h under contention, as the number of
+ * simulation threads grows. Each thread plays one robot:
+ *
+ *	realistic		robots wander their own part of the room, marking the
+ *					cell they stand on and reading the cell ahead; most
+ *					marks find the flag already set
+ *	adversarial		every robot marks and clears obstacles in the same tile,
+ *					so that every operation writes one contended cache line
+ *
+ * map_fetch_or is the realistic case with an unconditional atomic OR in
+ * place of irobotSharedMapMark(), to measure what the load before the OR
+ * saves. Results are written to stdout as JSON, one object per case and
+ * thread count.
+ *
+ * Build (Linux), from this directory:
+ *	gcc -O2 -I../.. -I../../.. -I../../../irobot -o mapbench main.c ../../irobotSharedMap.c -lm -lpthread
+ *
+ * Usage:
+ *	mapbench [-j largest thread count] [name filter]
+ */
+
+#define _GNU_SOURCE
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "irobotSharedMap.h"
+
+#define INPUT_COUNT			4096		///< positions per thread; power of 2
+#define INPUT_MASK			(INPUT_COUNT - 1)
+#define OPS_PER_THREAD		(INPUT_COUNT * 256)	///< operations timed per thread and run
+#define RUNS				5			///< timed runs per benchmark; the fastest is reported
+#define ROOM_SIZE			8000.0		///< side of the room, in mm
+#define CELL_SIZE			25.0		///< side of a map cell, in mm
+#define STEP_SIZE			10.0		///< distance a robot wanders between operations, in mm
+#define DEFAULT_THREADS		64			///< largest thread count, unless given
+
+/// One robot position
+typedef struct{
+	double		x;						///< position, in mm
+	double		y;						///< position, in mm
+	double		aheadX;					///< position of the cell ahead, in mm
+	double		aheadY;					///< position of the cell ahead, in mm
+} mapInput_t;
+
+/// Simulation thread
+typedef struct{
+	pthread_t				thread;
+	uint32_t				index;		///< thread number
+	mapInput_t *			inputs;		///< positions visited in turn
+	const struct benchmarkCase_s *	pCase;	///< case being run
+	uint64_t				sum;		///< results, so the compiler cannot discard the work
+} mapThread_t;
+
+/// Benchmark case
+typedef struct benchmarkCase_s{
+	const char *	name;					///< operation being measured
+	const char *	input;					///< input distribution
+	void			(*setup)(mapThread_t * const pThread, const uint32_t nThreads);	///< generate inputs; not timed
+	uint64_t		(*run)(const mapThread_t * const pThread, const uint32_t nOps);	///< execute nOps operations
+} benchmarkCase_t;
+
+static irobotSharedMap_t *	pMap;
+
+// threads wait here, so that they all start at once
+static pthread_barrier_t	startBarrier;
+
+static uint64_t clockNs(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/// xorshift64; deterministic so that runs are comparable
+static uint32_t randomNext(uint64_t * const pState){
+	*pState ^= *pState << 13;
+	*pState ^= *pState >> 7;
+	*pState ^= *pState << 17;
+	return (uint32_t)(*pState >> 32);
+}
+
+/// \returns uniform double in [-1, 1]
+static double randomUnit(uint64_t * const pState){
+	return (double)randomNext(pState) / 2147483648.0 - 1.0;
+}
+
+//*****************************************************
+// inputs                                             *
+//*****************************************************
+
+/// Wander from a start in the thread's own strip of the room, turning a
+/// little every step and reflecting off the walls.
+static void setupRealistic(mapThread_t * const pThread, const uint32_t nThreads){
+	uint64_t	state = 0x2545F4914F6CDD1DULL + pThread->index;
+	const double half = ROOM_SIZE / 2 - CELL_SIZE;
+	double		x = -half + ROOM_SIZE * (pThread->index + 0.5) / nThreads;
+	double		y = 0;
+	double		heading = M_PI * randomUnit(&state);
+	uint32_t	i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		heading += 0.1 * randomUnit(&state);
+		x += STEP_SIZE * cos(heading);
+		y += STEP_SIZE * sin(heading);
+		if(fabs(x) > half){
+			x = copysign(half, x);
+			heading = M_PI - heading;
+		}
+		if(fabs(y) > half){
+			y = copysign(half, y);
+			heading = -heading;
+		}
+		pThread->inputs[i].x = x;
+		pThread->inputs[i].y = y;
+		pThread->inputs[i].aheadX = x + CELL_SIZE * cos(heading);
+		pThread->inputs[i].aheadY = y + CELL_SIZE * sin(heading);
+	}
+}
+
+/// Every thread in the same tile, each on its own cell.
+static void setupAdversarial(mapThread_t * const pThread, const uint32_t nThreads){
+	const uint32_t	cell = pThread->index % SHARED_MAP_TILE_CELLS;
+	const double	x = pMap->originX + (cell % SHARED_MAP_TILE_SIDE + 0.5) * CELL_SIZE;
+	const double	y = pMap->originY + (cell / SHARED_MAP_TILE_SIDE + 0.5) * CELL_SIZE;
+	uint32_t		i;
+
+	for(i = 0; i < INPUT_COUNT; i++){
+		pThread->inputs[i].x = x;
+		pThread->inputs[i].y = y;
+		pThread->inputs[i].aheadX = x;
+		pThread->inputs[i].aheadY = y;
+	}
+}
+
+//*****************************************************
+// operations                                         *
+//*****************************************************
+
+/// Mark the cell underneath and read the cell ahead.
+static uint64_t runMark(const mapThread_t * const pThread, const uint32_t nOps){
+	uint64_t	sum = 0;
+	uint32_t	i;
+
+	for(i = 0; i < nOps; i++){
+		const mapInput_t * const pInput = &pThread->inputs[i & INPUT_MASK];
+
+		sum += irobotSharedMapMark(pMap, pInput->x, pInput->y, SHARED_MAP_VISITED);
+		sum += irobotSharedMapRead(pMap, pInput->aheadX, pInput->aheadY);
+	}
+	return sum;
+}
+
+/// Mark the cell underneath with an unconditional atomic OR, and read the cell ahead.
+static uint64_t runFetchOr(const mapThread_t * const pThread, const uint32_t nOps){
+	uint64_t	sum = 0;
+	uint32_t	i;
+
+	for(i = 0; i < nOps; i++){
+		const mapInput_t * const	pInput = &pThread->inputs[i & INPUT_MASK];
+		_Atomic uint8_t * const		pCell = irobotSharedMapCell(pMap, pInput->x, pInput->y);
+
+		if(pCell){
+			sum += atomic_fetch_or_explicit(pCell, SHARED_MAP_VISITED, memory_order_relaxed);
+		}
+		sum += irobotSharedMapRead(pMap, pInput->aheadX, pInput->aheadY);
+	}
+	return sum;
+}
+
+/// Alternately mark and clear an obstacle, so that every operation writes.
+static uint64_t runToggle(const mapThread_t * const pThread, const uint32_t nOps){
+	uint64_t	sum = 0;
+	uint32_t	i;
+
+	for(i = 0; i < nOps; i++){
+		const mapInput_t * const pInput = &pThread->inputs[i & INPUT_MASK];
+
+		if(i & 1){
+			sum += irobotSharedMapClear(pMap, pInput->x, pInput->y, SHARED_MAP_OBSTACLE);
+		}
+		else{
+			sum += irobotSharedMapMark(pMap, pInput->x, pInput->y, SHARED_MAP_OBSTACLE);
+		}
+	}
+	return sum;
+}
+
+static const benchmarkCase_t cases[] = {
+	{"map_mark",		"realistic",	setupRealistic,		runMark},
+	{"map_mark",		"adversarial",	setupAdversarial,	runToggle},
+	{"map_fetch_or",	"realistic",	setupRealistic,		runFetchOr},
+};
+
+//*****************************************************
+// harness                                            *
+//*****************************************************
+
+static void * mapThreadRun(void * const pArg){
+	mapThread_t * const pThread = (mapThread_t*)pArg;
+
+	pThread->pCase->run(pThread, INPUT_COUNT);		// warm caches and predictors
+	pthread_barrier_wait(&startBarrier);
+	pThread->sum += pThread->pCase->run(pThread, OPS_PER_THREAD);
+	return NULL;
+}
+
+/// Time one case at one thread count and write its JSON object.
+static void benchmarkRun(
+	const benchmarkCase_t * const	pCase,
+	mapThread_t * const				threads,
+	const uint32_t					nThreads,
+	const bool						first
+){
+	uint64_t	bestNs = UINT64_MAX;
+	uint64_t	sum = 0;
+	uint32_t	run;
+	uint32_t	t;
+
+	for(t = 0; t < nThreads; t++){
+		threads[t].index = t;
+		threads[t].pCase = pCase;
+		threads[t].sum = 0;
+		pCase->setup(&threads[t], nThreads);
+	}
+
+	for(run = 0; run < RUNS; run++){
+		uint64_t ns;
+
+		irobotSharedMapInit(pMap, ROOM_SIZE, CELL_SIZE);
+		pthread_barrier_init(&startBarrier, NULL, nThreads + 1);
+		for(t = 0; t < nThreads; t++){
+			if(pthread_create(&threads[t].thread, NULL, mapThreadRun, &threads[t]) != 0){
+				fprintf(stderr, "mapbench: could not start %u threads\n", nThreads);
+				exit(EXIT_FAILURE);
+			}
+		}
+		pthread_barrier_wait(&startBarrier);
+		ns = clockNs();
+		for(t = 0; t < nThreads; t++){
+			pthread_join(threads[t].thread, NULL);
+		}
+		ns = clockNs() - ns;
+		pthread_barrier_destroy(&startBarrier);
+
+		if(ns < bestNs){
+			bestNs = ns;
+		}
+	}
+	for(t = 0; t < nThreads; t++){
+		sum += threads[t].sum;
+	}
+
+	printf("%s\n\t\t{\"name\": \"%s\", \"input\": \"%s\", \"threads\": %u", first ? "" : ",", pCase->name, pCase->input, nThreads);
+	printf(", \"ops\": %llu, \"mops_per_s\": %.1f, \"ns_per_op_per_thread\": %.3f, \"checksum\": %llu}",
+			(unsigned long long)OPS_PER_THREAD * nThreads,
+			(double)OPS_PER_THREAD * nThreads * 1000 / bestNs,
+			(double)bestNs / OPS_PER_THREAD,
+			(unsigned long long)sum);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t		maxThreads = DEFAULT_THREADS;
+	const char *	filter = NULL;
+	mapThread_t *	threads;
+	void *			pMemory;
+	bool			first = true;
+	uint32_t		nThreads;
+	size_t			i;
+	int				option;
+
+	while((option = getopt(argc, argv, "j:")) != -1){
+		switch(option){
+		case 'j': maxThreads = (uint32_t)strtoul(optarg, NULL, 10); break;
+		default:
+			fprintf(stderr, "Usage: %s [-j largest thread count] [name filter]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if(optind < argc){
+		filter = argv[optind];
+	}
+	if(maxThreads == 0){
+		maxThreads = 1;
+	}
+
+	pMemory = aligned_alloc(64, (irobotSharedMapSize(ROOM_SIZE, CELL_SIZE) + 63) / 64 * 64);
+	threads = calloc(maxThreads, sizeof(*threads));
+	for(nThreads = 0; threads && nThreads < maxThreads; nThreads++){
+		threads[nThreads].inputs = malloc(INPUT_COUNT * sizeof(mapInput_t));
+		if(!threads[nThreads].inputs){
+			break;
+		}
+	}
+	if(!pMemory || !threads || nThreads < maxThreads){
+		fprintf(stderr, "mapbench: out of memory\n");
+		return EXIT_FAILURE;
+	}
+	pMap = irobotSharedMapInit(pMemory, ROOM_SIZE, CELL_SIZE);
+
+	printf("{\n\t\"cpus\": %ld,\n\t\"benchmarks\": [", sysconf(_SC_NPROCESSORS_ONLN));
+	for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++){
+		if(filter && !strstr(cases[i].name, filter)){
+			continue;
+		}
+		for(nThreads = 1; nThreads <= maxThreads; nThreads = nThreads < maxThreads && nThreads * 2 > maxThreads ? maxThreads : nThreads * 2){
+			benchmarkRun(&cases[i], threads, nThreads, first);
+			first = false;
+			if(nThreads == maxThreads){
+				break;
+			}
+		}
+	}
+	printf("\n\t]\n}\n");
+
+	for(nThreads = 0; nThreads < maxThreads; nThreads++){
+		free(threads[nThreads].inputs);
+	}
+	free(threads);
+	free(pMemory);
+
+	return 0;
+}
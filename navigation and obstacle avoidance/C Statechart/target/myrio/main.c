@@ -1,7 +1,25 @@
 /** \file main.c
  *
  * Top-level application for navigating the iRobot Create using
- * a myRIO microcontroller.
+ * a myRIO microcontroller. Provides the myRIO clock, UART and accelerometer
+ * to the control loop in irobotApp.c through an irobotHal_t.
+ *
+ * Define STATECHART_PLUGIN to load the statechart from a shared library
+ * given on the command line instead of linking it. The library is
+ * reloaded whenever it is rebuilt with csccompile.sh. If the library is
+ * built with STATECHART_COVERAGE, link irobotStatechartCoverage.c and
+ * -rdynamic into this program; the library counts into its registry.
+ *
+ * Define IROBOT_STATECHART_VARIANTS, and link every variant with
+ * irobotStatechartVariants.c, to select the statechart by name on the
+ * command line; the first variant runs if none is given.
+ *
+ * Set scriptSegmentMs to run maneuvers as Open Interface scripts on the
+ * iRobot (irobotScript.h). A sensor poll during a segment is answered only
+ * when the iRobot's wait ends, so the poll timeout of the irobot library
+ * must exceed the odometry error of a segment. Scripts are not used with
+ * STATECHART_PLUGIN, since the maneuver must come from the statechart that
+ * is running.
  */
 
 #include <stdio.h>
@@ -15,7 +33,15 @@
 #include "UART.h"
 #include "irobot.h"
 #include "irobotNavigationStatechart.h"
+#include "irobotApp.h"
+#include "irobotHal.h"
+#include "irobotOpenInterface.h"
 #include "irobotSensorTypes.h"
+#ifdef STATECHART_PLUGIN
+	#include "irobotStatechartPlugin.h"
+#elif defined(IROBOT_STATECHART_VARIANTS)
+	#include "irobotStatechartVariants.h"
+#endif
 
 /// sensor roll
 void rroll(
@@ -32,33 +58,141 @@ void delayMs(
 	const uint64_t msDelay		///< [in] Length of delay, in ms
 );
 
-/// Wait until the system clock passes the next integer multiple of a period.
-/// Use to create periodic loops. This function will never delay more than
-///	msMultiple, but may delay less.
-void waitUntilNextMsMultiple(
-	const uint64_t msMultiple	///< Multiple clock must pass before unblocking, in ms
-);
-
 const int32_t driveDistance = 200;		// distance to drive, in mm
 const int32_t turnAngle = 90;			// angle to turn, in mm
-const double alpha = 0.2;				// accelerometer filter coefficient
+const double alpha = 0.2;				// accelerometer filter coefficient, at the nominal loop period
+const uint64_t pluginPollMs = 500;		// interval between checks for a rebuilt statechart library, in ms
+const uint32_t maxAcceleration = 1000;	// largest wheel acceleration, in mm/s^2
+const uint32_t driveRefreshMs = 1000;	// interval to resend an unchanged drive command, in ms
+const uint32_t scriptSegmentMs = 0;		// duration of a script segment, in ms; 0 commands every tick
+
+/// myRIO peripherals behind the HAL
+typedef struct{
+	MyRio_Accl				accelDevice;	///< onboard accelerometer
+	irobotUARTPort_t		port;			///< UART port of the iRobot
+#ifdef STATECHART_PLUGIN
+	irobotStatechartPlugin_t	plugin;			///< statechart library
+	uint64_t					msPluginPoll;	///< system clock at the last library check, in ms
+#endif
+} myrioHal_t;
+
+static uint64_t myrioTimeMs(void * const pContext){
+	return getTimeInMs();
+}
+
+static void myrioDelayMs(void * const pContext, const uint64_t ms){
+	delayMs(ms);
+}
+
+static int32_t myrioReadSensors(void * const pContext, irobotSensorGroup6_t * const pSensors){
+	return irobotSensorPollSensorGroup6(((myrioHal_t*)pContext)->port, pSensors);
+}
+
+static int32_t myrioDriveDirect(void * const pContext, const int16_t leftWheelSpeed, const int16_t rightWheelSpeed){
+	return irobotDriveDirect(((myrioHal_t*)pContext)->port, leftWheelSpeed, rightWheelSpeed);
+}
+
+static int32_t myrioUploadScript(void * const pContext, const uint8_t * const script, const uint8_t size){
+	const irobotUARTPort_t	port = ((myrioHal_t*)pContext)->port;
+	const uint8_t			header[2] = {OI_SCRIPT, size};
+	int32_t					status;
+
+	status = irobotUARTWriteRaw(port, header, sizeof(header));
+	NiFpga_IfIsNotError(status, irobotUARTWriteRaw(port, script, size));
+	return status;
+}
+
+static int32_t myrioPlayScript(void * const pContext){
+	const uint8_t command = OI_PLAY_SCRIPT;
+
+	return irobotUARTWriteRaw(((myrioHal_t*)pContext)->port, &command, 1);
+}
+
+static int32_t myrioReadAccelerometer(void * const pContext, accelerometer_t * const pAccel){
+	myrioHal_t * const pMyrio = (myrioHal_t*)pContext;
+
+	pAccel->x = Accel_ReadX(&pMyrio->accelDevice);
+	pAccel->y = Accel_ReadY(&pMyrio->accelDevice);
+	pAccel->z = Accel_ReadZ(&pMyrio->accelDevice);
+	return NiFpga_Status_Success;
+}
+
+/// Runs after every tick of the control loop.
+static void myrioOnTick(void * const pContext, const irobotSensorGroup6_t * const pSensors, irobotNavigationStatechart_t * const pStatechart){
+	// try uncommenting this line
+	// rroll(pSensors, ((myrioHal_t*)pContext)->port);
+
+#ifdef STATECHART_PLUGIN
+	myrioHal_t * const pMyrio = (myrioHal_t*)pContext;
+
+	// swap in a rebuilt statechart between ticks
+	if(getTimeInMs() - pMyrio->msPluginPoll >= pluginPollMs){
+		pMyrio->msPluginPoll = getTimeInMs();
+		if(irobotStatechartPluginReloadIfChanged(&pMyrio->plugin)){
+			*pStatechart = pMyrio->plugin.statechart;
+		}
+	}
+#endif
+}
 
 int main(int argc, char **argv)
 {
 	// Hardware peripherals
-	MyRio_Accl				accelDevice;
-	irobotUARTPort_t 		port = UART1;			///< UART port
+	myrioHal_t				myrio = {.port = UART1};
+	const irobotHal_t		hal = {
+		.pContext = &myrio,
+		.timeMs = myrioTimeMs,
+		.delayMs = myrioDelayMs,
+		.readSensors = myrioReadSensors,
+		.driveDirect = myrioDriveDirect,
+		.readAccelerometer = myrioReadAccelerometer,
+		.uploadScript = myrioUploadScript,
+		.playScript = myrioPlayScript,
+	};
 
-	// sensor inputs
-	irobotSensorGroup6_t	sensors;				///< irobot sensors
-	int32_t					netDistance = 0;		///< net distance the robot has traveled, in mm
-	int32_t					netAngle = 0;			///< net angle through which the robot has turned, in deg
-	accelerometer_t			accelValue = {0,0,0};	///< accelerometer, in g
-	static accelerometer_t	accelPrevValue ={0,0,0};///< previous accelerometer value
+	// control loop
+	irobotAppConfig_t		config = {
+		.alpha = alpha,
+		.maxAcceleration = maxAcceleration,
+		.driveRefreshMs = driveRefreshMs,
+		.isSimulator = false,
+		.verbose = true,
+		.durationMs = 0,
+		.onTick = myrioOnTick,
+		.pTickContext = &myrio,
+		.maneuver = NULL,
+		.scriptSegmentMs = scriptSegmentMs,
+	};
+	irobotAppStatistics_t	statistics = {0};
 
-	// actuator outputs
-	int16_t					leftWheelSpeed = 0;		///< speed of the left wheel, in mm/s
-	int16_t					rightWheelSpeed = 0;	///< speed of the right wheel, in mm/s
+	// statechart
+	irobotNavigationStatechart_t	statechart;		///< statechart executed each tick
+#ifdef STATECHART_PLUGIN
+	if(argc < 2 || !irobotStatechartPluginOpen(&myrio.plugin, argv[1])){
+		fprintf(stderr, "Usage: %s <statechart library>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	statechart = myrio.plugin.statechart;
+#elif defined(IROBOT_STATECHART_VARIANTS)
+	const irobotStatechartVariant_t *	pVariant;	///< statechart variant chosen on the command line
+	size_t								iVariant;
+
+	pVariant = argc > 1 ? irobotStatechartVariantFind(argv[1]) : &irobotStatechartVariants[0];
+	if(!pVariant){
+		fprintf(stderr, "Usage: %s [statechart variant]\nVariants:", argv[0]);
+		for(iVariant = 0; iVariant < irobotStatechartVariantCount; iVariant++){
+			fprintf(stderr, " %s", irobotStatechartVariants[iVariant].name);
+		}
+		fprintf(stderr, "\n");
+		return EXIT_FAILURE;
+	}
+	printf("statechart %s\n", pVariant->name);
+	statechart = pVariant->statechart;
+	config.maneuver = pVariant->maneuver;
+#else
+	statechart = irobotNavigationStatechart;
+	config.maneuver = irobotNavigationStatechartManeuver;
+#endif
 
     NiFpga_Status 			status;
 
@@ -69,72 +203,30 @@ int main(int argc, char **argv)
     }
 
 	// Specify the registers that correspond to the accelerometer channen that needs to be accessed.
-	accelDevice.xval = ACCXVAL;
-	accelDevice.yval = ACCYVAL;
-	accelDevice.zval = ACCZVAL;
-	accelDevice.scale_wght = ACCSCALEWGHT;
-	Accel_Scaling(&accelDevice);
+	myrio.accelDevice.xval = ACCXVAL;
+	myrio.accelDevice.yval = ACCYVAL;
+	myrio.accelDevice.zval = ACCZVAL;
+	myrio.accelDevice.scale_wght = ACCSCALEWGHT;
+	Accel_Scaling(&myrio.accelDevice);
 
 	// initialize iRobot */
-	NiFpga_IfIsNotError(status, irobotOpen(port));
+	NiFpga_IfIsNotError(status, irobotOpen(myrio.port));
 
 	// Read inputs, execute statechart, generate outputs, print debug information */
-	while(!NiFpga_IsError(status) && !sensors.buttons.advance){
-		// Read iRobot sensors
-		NiFpga_IfIsNotError(status, irobotSensorPollSensorGroup6(port, &sensors));
-		if(NiFpga_IsNotError(status)){
-			// accumulate distance and angle
-			netDistance += sensors.distance;
-			netAngle += sensors.angle;
-		}
-
-		// Read and filter accelerometer
-		if(NiFpga_IsNotError(status)){
-			accelValue.x = Accel_ReadX(&accelDevice);
-			accelValue.y = Accel_ReadY(&accelDevice);
-			accelValue.z = Accel_ReadZ(&accelDevice);
-		}
-		if(NiFpga_IsNotError(status)){
-			accelValue.x = alpha * accelValue.x + (1 - alpha) * accelPrevValue.x;
-			accelValue.y = alpha * accelValue.y + (1 - alpha) * accelPrevValue.y;
-			accelValue.z = alpha * accelValue.z + (1 - alpha) * accelPrevValue.z;
-			accelPrevValue = accelValue;
-		}
+	NiFpga_IfIsNotError(status, irobotAppRun(&hal, statechart, &config, &statistics));
 
-		// Execute statechart
-		irobotNavigationStatechart(
-			netDistance,
-			netAngle,
-			sensors,
-			accelValue,
-			false,
-			&leftWheelSpeed,
-			&rightWheelSpeed
-		);
-
-		// Produce outputs
-		NiFpga_IfIsNotError(status, irobotDriveDirect(port, leftWheelSpeed, rightWheelSpeed));
-
-		// print debug information
-		printf("\n\nx=%+.2f y=%+.2f z=%+.2f\nLWheel=%+3d RWheel=%+3d\n",
-				accelValue.x,
-				accelValue.y,
-				accelValue.z,
-				leftWheelSpeed,
-				rightWheelSpeed);
-
-		// try uncommenting this line */
-		// rroll(&sensors, port); */
-
-		// Loop timing
-		waitUntilNextMsMultiple(60);
-	}
+	// loop statistics
+	irobotAppPrintStatistics(&statistics);
 
 	// even if an error has occurred, close the UART port
-	NiFpga_MergeStatus(&status, irobotClose(port));
+	NiFpga_MergeStatus(&status, irobotClose(myrio.port));
 
     MyRio_Close();
 
+#ifdef STATECHART_PLUGIN
+	irobotStatechartPluginClose(&myrio.plugin);
+#endif
+
     MyRio_PrintStatus(status);
 
     return status;
@@ -150,13 +242,6 @@ void delayMs(const uint64_t msDelay){
 	usleep(msDelay * 1000);
 }
 
-void waitUntilNextMsMultiple(const uint64_t msMultiple){
-	const uint64_t msCounter = getTimeInMs() % msMultiple;
-	if(msCounter > 0){
-		delayMs(msMultiple - msCounter);
-	}
-}
-
 void rroll(const irobotSensorGroup6_t * const pSensors, const irobotUARTPort_t port){
 	static uint8_t bInitialized = 0;
 
@@ -0,0 +1,191 @@
+/** \file irobotStatechartPlugin.c
+ *
+ * Loads and hot-swaps a C Statechart shared library on Linux.
+ */
+
+#define _GNU_SOURCE
+#include "irobotStatechartPlugin.h"
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+
+/// Library loaded from a private copy
+typedef struct{
+	void *										handle;
+	irobotNavigationStatechart_t				statechart;
+	irobotNavigationStatechartContextSave_t		contextSave;
+	irobotNavigationStatechartContextRestore_t	contextRestore;
+} pluginLibrary_t;
+
+/// Copy a file into an open destination; used so that each generation of
+/// the library has its own path. dlopen() returns the already loaded object
+/// for a path it has seen, and the build may replace the library while it
+/// is mapped.
+static bool pluginCopyFile(const char * const source, const int out){
+	struct stat		sourceStat;
+	off_t			offset = 0;
+	bool			success = false;
+	int				in;
+
+	in = open(source, O_RDONLY | O_CLOEXEC);
+	if(in >= 0 && fstat(in, &sourceStat) == 0){
+		success = true;
+		while(success && offset < sourceStat.st_size){
+			success = sendfile(out, in, &offset, (size_t)(sourceStat.st_size - offset)) > 0;
+		}
+	}
+
+	if(in >= 0){
+		close(in);
+	}
+	return success;
+}
+
+/// Load a private copy of the library at path.
+static bool pluginLoad(irobotStatechartPlugin_t * const pPlugin, pluginLibrary_t * const pLibrary){
+	char			copyPath[PATH_MAX];
+	const char *	tmpDir = getenv("TMPDIR");
+	int				copyLength;
+	int				out;
+
+	if(!tmpDir || !*tmpDir){
+		tmpDir = "/tmp";
+	}
+	copyLength = snprintf(copyPath, sizeof(copyPath), "%s/statechart.XXXXXX", tmpDir);
+	if(copyLength < 0 || (size_t)copyLength >= sizeof(copyPath)){
+		fprintf(stderr, "irobotStatechartPlugin: TMPDIR is too long for a copy of the library\n");
+		return false;
+	}
+
+	// a fresh name, created exclusively, so that the copy never replaces someone else's file
+	out = mkostemp(copyPath, O_CLOEXEC);
+	if(out < 0){
+		fprintf(stderr, "irobotStatechartPlugin: could not create a copy in %s: %s\n", tmpDir, strerror(errno));
+		return false;
+	}
+	if(!pluginCopyFile(pPlugin->path, out)){
+		fprintf(stderr, "irobotStatechartPlugin: could not copy %s to %s\n", pPlugin->path, copyPath);
+		close(out);
+		unlink(copyPath);
+		return false;
+	}
+	close(out);
+
+	// the mapping outlives the file; nothing is left behind if the process dies
+	pLibrary->handle = dlopen(copyPath, RTLD_NOW | RTLD_LOCAL);
+	unlink(copyPath);
+	if(!pLibrary->handle){
+		fprintf(stderr, "irobotStatechartPlugin: %s\n", dlerror());
+		return false;
+	}
+
+	*(void **)&pLibrary->statechart = dlsym(pLibrary->handle, "irobotNavigationStatechart");
+	*(void **)&pLibrary->contextSave = dlsym(pLibrary->handle, "irobotNavigationStatechartContextSave");
+	*(void **)&pLibrary->contextRestore = dlsym(pLibrary->handle, "irobotNavigationStatechartContextRestore");
+	if(!pLibrary->statechart){
+		fprintf(stderr, "irobotStatechartPlugin: %s does not export irobotNavigationStatechart\n", pPlugin->path);
+		dlclose(pLibrary->handle);
+		return false;
+	}
+
+	pPlugin->generation++;
+	return true;
+}
+
+/// \returns true if the file has the given identity
+static bool pluginSameFile(const struct stat * const pStat, const irobotStatechartPluginFile_t * const pFile){
+	return pStat->st_dev == pFile->device
+		&& pStat->st_ino == pFile->inode
+		&& pStat->st_mtim.tv_sec == pFile->modified.tv_sec
+		&& pStat->st_mtim.tv_nsec == pFile->modified.tv_nsec;
+}
+
+/// Record the identity of a file.
+static void pluginFileSet(irobotStatechartPluginFile_t * const pFile, const struct stat * const pStat){
+	pFile->device = pStat->st_dev;
+	pFile->inode = pStat->st_ino;
+	pFile->modified = pStat->st_mtim;
+}
+
+/// Make a loaded library the active one.
+static void pluginActivate(irobotStatechartPlugin_t * const pPlugin, const pluginLibrary_t * const pLibrary, const struct stat * const pStat){
+	pPlugin->handle = pLibrary->handle;
+	pPlugin->statechart = pLibrary->statechart;
+	pPlugin->contextSave = pLibrary->contextSave;
+	pPlugin->contextRestore = pLibrary->contextRestore;
+	pluginFileSet(&pPlugin->loaded, pStat);
+}
+
+bool irobotStatechartPluginOpen(irobotStatechartPlugin_t * const pPlugin, const char * const path){
+	pluginLibrary_t		library;
+	struct stat			libraryStat;
+
+	memset(pPlugin, 0, sizeof(*pPlugin));
+	if(!path || strlen(path) >= sizeof(pPlugin->path)){
+		return false;
+	}
+	strcpy(pPlugin->path, path);
+
+	if(stat(path, &libraryStat) != 0){
+		fprintf(stderr, "irobotStatechartPlugin: cannot find %s\n", path);
+		return false;
+	}
+	if(!pluginLoad(pPlugin, &library)){
+		return false;
+	}
+
+	pluginActivate(pPlugin, &library, &libraryStat);
+	return true;
+}
+
+bool irobotStatechartPluginReloadIfChanged(irobotStatechartPlugin_t * const pPlugin){
+	pluginLibrary_t		library;
+	struct stat			libraryStat;
+	uint8_t				context[STATECHART_CONTEXT_MAX_SIZE];
+	size_t				contextSize = 0;
+
+	// a rebuild either replaces the file (new device or inode) or rewrites it (new mtime)
+	if(   !pPlugin->handle
+	   || stat(pPlugin->path, &libraryStat) != 0
+	   || pluginSameFile(&libraryStat, &pPlugin->loaded)
+	   || pluginSameFile(&libraryStat, &pPlugin->rejected)
+	){
+		return false;
+	}
+
+	// a library that is still being written fails to load; it is retried once the file changes again
+	if(!pluginLoad(pPlugin, &library)){
+		pluginFileSet(&pPlugin->rejected, &libraryStat);
+		return false;
+	}
+
+	if(pPlugin->contextSave){
+		contextSize = pPlugin->contextSave(context, sizeof(context));
+	}
+	if(contextSize == 0 || !library.contextRestore || !library.contextRestore(context, contextSize)){
+		fprintf(stderr, "irobotStatechartPlugin: context not carried over; %s starts from its initial state\n", pPlugin->path);
+	}
+
+	dlclose(pPlugin->handle);
+	pluginActivate(pPlugin, &library, &libraryStat);
+	fprintf(stderr, "irobotStatechartPlugin: reloaded %s (generation %u)\n", pPlugin->path, pPlugin->generation);
+
+	return true;
+}
+
+void irobotStatechartPluginClose(irobotStatechartPlugin_t * const pPlugin){
+	if(pPlugin->handle){
+		dlclose(pPlugin->handle);
+	}
+	pPlugin->handle = NULL;
+	pPlugin->statechart = NULL;
+	pPlugin->contextSave = NULL;
+	pPlugin->contextRestore = NULL;
+}
@@ -0,0 +1,62 @@
+/** \file irobotStatechartPlugin.h
+ *
+ * Loads a C Statechart from a shared library on Linux and reloads it when
+ * the library is rebuilt, carrying the statechart context across the swap.
+ * Build the library with csccompile.sh.
+ */
+
+#ifndef IROBOTSTATECHARTPLUGIN_H_
+#define IROBOTSTATECHARTPLUGIN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include <time.h>
+#include "irobotNavigationStatechart.h"
+
+/// Path length of a plugin library
+#define STATECHART_PLUGIN_PATH_SIZE		4096
+
+/// Identity of a library file: the file at the same path changes when a
+/// rebuild replaces it (new device or inode) or rewrites it (new mtime)
+typedef struct{
+	dev_t										device;				///< device
+	ino_t										inode;				///< inode
+	struct timespec								modified;			///< modification time
+} irobotStatechartPluginFile_t;
+
+/// A statechart loaded from a shared library
+typedef struct{
+	char										path[STATECHART_PLUGIN_PATH_SIZE];	///< library being watched
+	void *										handle;				///< handle of the loaded copy
+	irobotNavigationStatechart_t				statechart;			///< statechart in the loaded copy
+	irobotNavigationStatechartContextSave_t		contextSave;		///< context export, or NULL if not provided
+	irobotNavigationStatechartContextRestore_t	contextRestore;		///< context import, or NULL if not provided
+	irobotStatechartPluginFile_t				loaded;				///< library that is loaded
+	irobotStatechartPluginFile_t				rejected;			///< last library that failed to load
+	uint32_t									generation;			///< number of libraries loaded
+} irobotStatechartPlugin_t;
+
+/// Load a statechart library.
+/// \returns true if the library was loaded and provides irobotNavigationStatechart()
+bool irobotStatechartPluginOpen(
+	irobotStatechartPlugin_t * const	pPlugin,	///< [out] plugin
+	const char * const					path		///< [in] path to the statechart library
+);
+
+/// Reload the library if it changed since it was loaded. Call between
+/// statechart executions. The context of the running statechart is restored
+/// into the new one; if the new statechart does not accept it, the new
+/// statechart starts from its initial state. If the new library cannot be
+/// loaded, the running statechart is kept.
+/// \returns true if a new library was swapped in
+bool irobotStatechartPluginReloadIfChanged(
+	irobotStatechartPlugin_t * const	pPlugin		///< [in,out] plugin
+);
+
+/// Unload the statechart library.
+void irobotStatechartPluginClose(
+	irobotStatechartPlugin_t * const	pPlugin		///< [in,out] plugin
+);
+
+#endif // IROBOTSTATECHARTPLUGIN_H_
@@ -0,0 +1,495 @@
+/** \file irobotCreateStandIn.c
+ *
+ * Stand-in for the iRobot Create on the other end of the UART.
+ */
+
+#define _USE_MATH_DEFINES
+#include "irobotCreateStandIn.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ROBOT_RADIUS		170.0		// radius of the robot, in mm
+#define WALL_SENSOR_RANGE	50.0		// range of the wall sensor beyond the robot, in mm
+#define DEG_PER_RAD			(180.0 / M_PI)
+
+/// Size of sensor packets 7 through 42, which make up group 6, in bytes
+static const uint8_t packetSize[36] = {
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,		// 7-18: bumps through buttons
+	2, 2, 1, 2, 2, 1, 2, 2,					// 19-26: distance through battery capacity
+	2, 2, 2, 2, 2, 1, 2, 1, 1, 1, 1, 1,		// 27-38: wall signal through stream packets
+	2, 2, 2, 2								// 39-42: requested velocities
+};
+
+/// \returns offset of sensor packet 7 through 43 within group 6, in bytes
+static uint32_t packetOffset(const uint8_t id){
+	uint32_t offset = 0;
+	uint8_t i;
+
+	for(i = 7; i < id; i++){
+		offset += packetSize[i - 7];
+	}
+	return offset;
+}
+
+/// Find the packets of group 6 that make up a sensor packet id.
+/// \returns false if the id is unknown
+static bool packetRange(const uint8_t id, uint8_t * const pFirst, uint8_t * const pLast){
+	static const uint8_t groups[7][2] = {{7, 26}, {7, 16}, {17, 20}, {21, 26}, {27, 34}, {35, 42}, {7, 42}};
+
+	if(id < 7){
+		*pFirst = groups[id][0];
+		*pLast = groups[id][1];
+		return true;
+	}
+	else if(id <= 42){
+		*pFirst = *pLast = id;
+		return true;
+	}
+	return false;
+}
+
+/// \returns length of the command in the buffer, or 0 if more bytes are needed to know it
+static uint32_t commandSize(const uint8_t * const command, const uint32_t length){
+	switch(command[0]){
+	case OI_START:
+	case OI_CONTROL:
+	case OI_SAFE:
+	case OI_FULL:
+	case OI_SPOT:
+	case OI_COVER:
+	case OI_COVER_AND_DOCK:
+	case OI_PLAY_SCRIPT:
+	case OI_SHOW_SCRIPT:
+		return 1;
+	case OI_BAUD:
+	case OI_DEMO:
+	case OI_LOW_SIDE_DRIVERS:
+	case OI_PLAY:
+	case OI_SENSORS:
+	case OI_DIGITAL_OUTPUTS:
+	case OI_PAUSE_RESUME_STREAM:
+	case OI_SEND_IR:
+	case OI_WAIT_TIME:
+	case OI_WAIT_EVENT:
+		return 2;
+	case OI_WAIT_DISTANCE:
+	case OI_WAIT_ANGLE:
+		return 3;
+	case OI_LEDS:
+	case OI_PWM_LOW_SIDE_DRIVERS:
+		return 4;
+	case OI_DRIVE:
+	case OI_DRIVE_DIRECT:
+		return 5;
+	case OI_SONG:
+		return length < 3 ? 0 : 3 + 2 * (uint32_t)command[2];
+	case OI_STREAM:
+	case OI_QUERY_LIST:
+	case OI_SCRIPT:
+		return length < 2 ? 0 : 2 + (uint32_t)command[1];
+	default:
+		return 1;
+	}
+}
+
+static void standInReply(irobotCreateStandIn_t * const pCreate, const uint8_t * const bytes, const size_t nBytes){
+	// like a UART overrun, bytes the host does not collect are lost
+	if(pCreate->replyLength + nBytes <= STANDIN_REPLY_SIZE){
+		memcpy(&pCreate->reply[pCreate->replyLength], bytes, nBytes);
+		pCreate->replyLength += nBytes;
+	}
+}
+
+static void putInt16(uint8_t * const bytes, const int32_t value){
+	bytes[0] = (uint8_t)((uint16_t)value >> 8);
+	bytes[1] = (uint8_t)value;
+}
+
+/// \returns true if a point at the given bearing and range from the robot is outside the room, or in a wall
+static bool standInOutside(const irobotCreateStandIn_t * const pCreate, const double bearing, const double range){
+	const double x = pCreate->x + range * cos(pCreate->heading + bearing);
+	const double y = pCreate->y + range * sin(pCreate->heading + bearing);
+
+	if(pCreate->pWorld){
+		return irobotWorldCell(pCreate->pWorld, x, y) == IROBOT_WORLD_WALL;
+	}
+	return fabs(x) > pCreate->roomSize / 2 || fabs(y) > pCreate->roomSize / 2;
+}
+
+/// \returns true if a point at the given bearing and range from the robot is over a cliff
+static bool standInCliff(const irobotCreateStandIn_t * const pCreate, const double bearing, const double range){
+	return pCreate->pWorld
+		&& irobotWorldCell(pCreate->pWorld,
+						   pCreate->x + range * cos(pCreate->heading + bearing),
+						   pCreate->y + range * sin(pCreate->heading + bearing)) == IROBOT_WORLD_CLIFF;
+}
+
+/// Encode sensor group 6. Reading distance or angle resets it, as on the Create.
+static void standInSensorGroup6(irobotCreateStandIn_t * const pCreate, uint8_t * const group6, const uint8_t first, const uint8_t last){
+	const bool	wall = standInOutside(pCreate, -M_PI / 2, ROBOT_RADIUS + WALL_SENSOR_RANGE);
+	int32_t		distance = 0;
+	int32_t		angle = 0;
+
+	if(first <= 19 && last >= 19){
+		distance = (int32_t)lround(pCreate->distance);
+		pCreate->distance -= distance;
+	}
+	if(first <= 20 && last >= 20){
+		angle = (int32_t)lround(pCreate->angle);
+		pCreate->angle -= angle;
+	}
+
+	memset(group6, 0, STANDIN_GROUP6_SIZE);
+	group6[packetOffset(7)] = (pCreate->bumpRight ? 0x01 : 0) | (pCreate->bumpLeft ? 0x02 : 0) | (pCreate->wheelDrop ? 0x1C : 0);
+	group6[packetOffset(8)] = wall;
+	group6[packetOffset(9)] = standInCliff(pCreate, M_PI / 3, ROBOT_RADIUS);
+	group6[packetOffset(10)] = standInCliff(pCreate, M_PI / 12, ROBOT_RADIUS);
+	group6[packetOffset(11)] = standInCliff(pCreate, -M_PI / 12, ROBOT_RADIUS);
+	group6[packetOffset(12)] = standInCliff(pCreate, -M_PI / 3, ROBOT_RADIUS);
+	group6[packetOffset(18)] = (pCreate->buttonPlay ? 0x01 : 0) | (pCreate->buttonAdvance ? 0x04 : 0);
+	putInt16(&group6[packetOffset(19)], distance);
+	putInt16(&group6[packetOffset(20)], angle);
+	group6[packetOffset(21)] = 0;							// not charging
+	putInt16(&group6[packetOffset(22)], 16000);				// voltage, in mV
+	putInt16(&group6[packetOffset(23)], -200);				// current, in mA
+	group6[packetOffset(24)] = 25;							// battery temperature, in C
+	putInt16(&group6[packetOffset(25)], 2500);				// battery charge, in mAh
+	putInt16(&group6[packetOffset(26)], 2700);				// battery capacity, in mAh
+	putInt16(&group6[packetOffset(27)], wall ? 200 : 0);	// wall signal
+	group6[packetOffset(35)] = pCreate->oiMode;
+	group6[packetOffset(38)] = (uint8_t)pCreate->nStreamIds;
+	putInt16(&group6[packetOffset(39)], (pCreate->leftWheelSpeed + pCreate->rightWheelSpeed) / 2);
+	putInt16(&group6[packetOffset(41)], pCreate->rightWheelSpeed);
+	putInt16(&group6[packetOffset(42)], pCreate->leftWheelSpeed);
+}
+
+/// Append a sensor packet to a buffer.
+/// \returns number of bytes written; 0 for an unknown packet id
+static size_t standInSensorPacket(irobotCreateStandIn_t * const pCreate, const uint8_t id, uint8_t * const bytes){
+	uint8_t		group6[STANDIN_GROUP6_SIZE];
+	uint8_t		first;
+	uint8_t		last;
+	uint32_t	offset;
+	uint32_t	size;
+
+	if(!packetRange(id, &first, &last)){
+		return 0;
+	}
+
+	standInSensorGroup6(pCreate, group6, first, last);
+	offset = packetOffset(first);
+	size = packetOffset(last) + packetSize[last - 7] - offset;
+	memcpy(bytes, &group6[offset], size);
+
+	return size;
+}
+
+/// Send one stream packet: header, size, then id and data for each packet, then checksum.
+static void standInStream(irobotCreateStandIn_t * const pCreate){
+	uint8_t		packet[3 + STANDIN_STREAM_IDS * (1 + STANDIN_GROUP6_SIZE)];
+	size_t		length = 2;
+	uint8_t		checksum = 0;
+	uint32_t	i;
+
+	// the size byte limits a stream packet to 255 bytes of ids and data
+	for(i = 0; i < pCreate->nStreamIds && length + 1 + STANDIN_GROUP6_SIZE <= 2 + 255; i++){
+		packet[length++] = pCreate->streamIds[i];
+		length += standInSensorPacket(pCreate, pCreate->streamIds[i], &packet[length]);
+	}
+	packet[0] = 19;
+	packet[1] = (uint8_t)(length - 2);
+	for(i = 0; i < length; i++){
+		checksum += packet[i];
+	}
+	packet[length++] = (uint8_t)(0x100 - checksum);
+
+	standInReply(pCreate, packet, length);
+}
+
+static void standInDriveDirect(irobotCreateStandIn_t * const pCreate, const int16_t rightWheelSpeed, const int16_t leftWheelSpeed){
+	pCreate->nDriveCommands++;
+	if(rightWheelSpeed == pCreate->rightWheelSpeed && leftWheelSpeed == pCreate->leftWheelSpeed){
+		pCreate->nRedundantDriveCommands++;
+	}
+	if(pCreate->reactionPending && (leftWheelSpeed + rightWheelSpeed) / 2.0 < pCreate->reactionSpeed){
+		pCreate->reactionPending = false;
+		pCreate->nReactions++;
+		pCreate->reactionMsTotal += pCreate->reactionMs;
+		if(pCreate->reactionMs > pCreate->reactionMsMax){
+			pCreate->reactionMsMax = pCreate->reactionMs;
+		}
+	}
+	pCreate->rightWheelSpeed = rightWheelSpeed;
+	pCreate->leftWheelSpeed = leftWheelSpeed;
+}
+
+static void standInParse(irobotCreateStandIn_t * const pCreate, const uint8_t * const bytes, const size_t nBytes);
+static void standInExecute(irobotCreateStandIn_t * const pCreate, const uint8_t * const command);
+
+/// End the playing script, and act on the serial input held meanwhile.
+static void standInScriptEnd(irobotCreateStandIn_t * const pCreate){
+	uint8_t			held[STANDIN_HOLD_SIZE];
+	const size_t	heldLength = pCreate->heldLength;
+
+	pCreate->scriptPlaying = false;
+	pCreate->waitOpcode = 0;
+	memcpy(held, pCreate->held, heldLength);
+	pCreate->heldLength = 0;
+	standInParse(pCreate, held, heldLength);
+}
+
+/// Execute script commands until a wait holds the script, or it ends.
+static void standInScriptRun(irobotCreateStandIn_t * const pCreate){
+	while(pCreate->scriptPlaying && pCreate->waitOpcode == 0){
+		const uint8_t * const	command = &pCreate->script[pCreate->scriptPosition];
+		const uint32_t			left = pCreate->scriptLength - pCreate->scriptPosition;
+		const uint32_t			size = left > 0 ? commandSize(command, left) : 0;
+
+		if(size == 0 || size > left){
+			// played to the end, or the script ends in a partial command
+			standInScriptEnd(pCreate);
+			break;
+		}
+		pCreate->scriptPosition += size;
+
+		switch(command[0]){
+		case OI_WAIT_DISTANCE:
+		case OI_WAIT_ANGLE:
+			pCreate->waitOpcode = command[0];
+			pCreate->waitRemaining = (int16_t)((command[1] << 8) | command[2]);
+			pCreate->waitNegative = pCreate->waitRemaining < 0;
+			break;
+		case OI_WAIT_TIME:
+			pCreate->waitOpcode = command[0];
+			pCreate->waitRemaining = 100.0 * command[1];	// in tenths of a second
+			pCreate->waitNegative = false;
+			break;
+		case OI_WAIT_EVENT:
+		case OI_SCRIPT:
+		case OI_PLAY_SCRIPT:
+			// events are not modeled; a script neither replaces nor restarts itself
+			break;
+		default:
+			standInExecute(pCreate, command);
+			break;
+		}
+	}
+}
+
+/// Execute a complete command.
+static void standInExecute(irobotCreateStandIn_t * const pCreate, const uint8_t * const command){
+	uint8_t		bytes[STANDIN_STREAM_IDS * STANDIN_GROUP6_SIZE];
+	size_t		length = 0;
+	uint32_t	i;
+
+	pCreate->nCommands++;
+	switch(command[0]){
+	case OI_START:
+		pCreate->oiMode = 1;
+		break;
+	case OI_CONTROL:
+	case OI_SAFE:
+		pCreate->oiMode = 2;
+		break;
+	case OI_FULL:
+		pCreate->oiMode = 3;
+		break;
+	case OI_DRIVE_DIRECT:
+		standInDriveDirect(pCreate,
+						   (int16_t)((command[1] << 8) | command[2]),
+						   (int16_t)((command[3] << 8) | command[4]));
+		break;
+	case OI_SENSORS:
+		pCreate->nSensorQueries++;
+		length = standInSensorPacket(pCreate, command[1], bytes);
+		break;
+	case OI_QUERY_LIST:
+		pCreate->nSensorQueries++;
+		for(i = 0; i < command[1] && length + STANDIN_GROUP6_SIZE <= sizeof(bytes); i++){
+			length += standInSensorPacket(pCreate, command[2 + i], &bytes[length]);
+		}
+		break;
+	case OI_STREAM:
+		pCreate->nStreamIds = command[1] < STANDIN_STREAM_IDS ? command[1] : STANDIN_STREAM_IDS;
+		memcpy(pCreate->streamIds, &command[2], pCreate->nStreamIds);
+		pCreate->streamPaused = false;
+		pCreate->msUntilStream = STANDIN_STREAM_PERIOD_MS;
+		break;
+	case OI_PAUSE_RESUME_STREAM:
+		pCreate->streamPaused = command[1] == 0;
+		break;
+	case OI_SCRIPT:
+		pCreate->nScriptUploads++;
+		pCreate->scriptLength = command[1] < OI_SCRIPT_MAX_SIZE ? command[1] : OI_SCRIPT_MAX_SIZE;
+		memcpy(pCreate->script, &command[2], pCreate->scriptLength);
+		break;
+	case OI_PLAY_SCRIPT:
+		pCreate->nScriptPlays++;
+		pCreate->scriptPlaying = true;
+		pCreate->scriptPosition = 0;
+		pCreate->waitOpcode = 0;
+		standInScriptRun(pCreate);
+		break;
+	case OI_SHOW_SCRIPT:
+		bytes[0] = (uint8_t)pCreate->scriptLength;
+		memcpy(&bytes[1], pCreate->script, pCreate->scriptLength);
+		length = 1 + pCreate->scriptLength;
+		break;
+	default:
+		// accepted and ignored
+		break;
+	}
+
+	if(length > 0){
+		standInReply(pCreate, bytes, length);
+	}
+}
+
+void irobotCreateStandInInit(irobotCreateStandIn_t * const pCreate, const double roomSize){
+	memset(pCreate, 0, sizeof(*pCreate));
+	pCreate->oiMode = 1;
+	pCreate->roomSize = roomSize;
+}
+
+void irobotCreateStandInSetWorld(irobotCreateStandIn_t * const pCreate, const irobotWorld_t * const pWorld){
+	pCreate->pWorld = pWorld;
+	pCreate->roomSize = pWorld->pHeader->roomSize;
+	pCreate->x = pWorld->pHeader->startX;
+	pCreate->y = pWorld->pHeader->startY;
+	pCreate->heading = pWorld->pHeader->startHeading;
+	pCreate->wheelDrop = false;
+}
+
+/// Parse serial input, executing each command as it completes.
+static void standInParse(irobotCreateStandIn_t * const pCreate, const uint8_t * const bytes, const size_t nBytes){
+	size_t i;
+
+	for(i = 0; i < nBytes; i++){
+		uint32_t size;
+
+		if(pCreate->scriptPlaying){
+			// a playing script does not react to serial input; like a UART overrun, what does not fit is lost
+			const size_t nHeld = nBytes - i < STANDIN_HOLD_SIZE - pCreate->heldLength ? nBytes - i : STANDIN_HOLD_SIZE - pCreate->heldLength;
+
+			memcpy(&pCreate->held[pCreate->heldLength], &bytes[i], nHeld);
+			pCreate->heldLength += nHeld;
+			return;
+		}
+		if(pCreate->commandLength == 0 && bytes[i] < OI_START){
+			// not an opcode; resynchronize on the next byte
+			pCreate->nUnknownBytes++;
+			continue;
+		}
+
+		pCreate->command[pCreate->commandLength++] = bytes[i];
+		size = commandSize(pCreate->command, pCreate->commandLength);
+		if(size > STANDIN_COMMAND_SIZE){
+			pCreate->nUnknownBytes += pCreate->commandLength;
+			pCreate->commandLength = 0;
+		}
+		else if(size > 0 && pCreate->commandLength == size){
+			standInExecute(pCreate, pCreate->command);
+			pCreate->commandLength = 0;
+		}
+	}
+}
+
+void irobotCreateStandInReceive(irobotCreateStandIn_t * const pCreate, const uint8_t * const bytes, const size_t nBytes){
+	pCreate->bytesReceived += nBytes;
+	standInParse(pCreate, bytes, nBytes);
+}
+
+void irobotCreateStandInAdvance(irobotCreateStandIn_t * const pCreate, const uint32_t ms){
+	uint32_t step;
+
+	// integrate in 1 ms steps, so that the bumpers trigger at the wall
+	for(step = 0; step < ms; step++){
+		// once over a cliff, the wheels hang free and the robot stays put
+		const double dt = pCreate->wheelDrop ? 0 : 0.001;
+		const double velocity = (pCreate->leftWheelSpeed + pCreate->rightWheelSpeed) / 2.0;
+		const double turnRate = (pCreate->rightWheelSpeed - pCreate->leftWheelSpeed) / OI_WHEEL_BASE;
+		const double previousX = pCreate->x;
+		const double previousY = pCreate->y;
+		const bool bumped = pCreate->bumpLeft || pCreate->bumpRight;
+
+		pCreate->heading += turnRate * dt;
+		pCreate->angle += turnRate * dt * DEG_PER_RAD;
+		pCreate->x += velocity * dt * cos(pCreate->heading);
+		pCreate->y += velocity * dt * sin(pCreate->heading);
+
+		pCreate->bumpLeft = standInOutside(pCreate, M_PI / 4, ROBOT_RADIUS);
+		pCreate->bumpRight = standInOutside(pCreate, -M_PI / 4, ROBOT_RADIUS);
+		if((pCreate->bumpLeft || pCreate->bumpRight) && velocity > 0){
+			// pushing against the wall; the wheels slip
+			pCreate->x = previousX;
+			pCreate->y = previousY;
+		}
+		else{
+			pCreate->distance += velocity * dt;
+		}
+		if(pCreate->reactionPending){
+			pCreate->reactionMs++;
+		}
+		else if(!bumped && (pCreate->bumpLeft || pCreate->bumpRight) && velocity > 0 && !pCreate->wheelDrop){
+			// the bumper has just closed; time the host until it slows down
+			pCreate->reactionPending = true;
+			pCreate->reactionSpeed = velocity;
+			pCreate->reactionMs = 0;
+		}
+		pCreate->wheelDrop = pCreate->wheelDrop || standInCliff(pCreate, 0, 0);
+
+		// a waiting script counts wheel travel, slipping or not, as the Create's odometry does
+		if(pCreate->scriptPlaying && pCreate->wheelDrop){
+			standInScriptEnd(pCreate);
+		}
+		else if(pCreate->waitOpcode != 0){
+			pCreate->waitRemaining -= pCreate->waitOpcode == OI_WAIT_DISTANCE ? velocity * dt
+									: pCreate->waitOpcode == OI_WAIT_ANGLE ? turnRate * dt * DEG_PER_RAD
+									: 1;
+			if(pCreate->waitNegative ? pCreate->waitRemaining >= 0 : pCreate->waitRemaining <= 0){
+				pCreate->waitOpcode = 0;
+				standInScriptRun(pCreate);
+			}
+		}
+
+		if(pCreate->nStreamIds > 0 && !pCreate->streamPaused && --pCreate->msUntilStream == 0){
+			pCreate->msUntilStream = STANDIN_STREAM_PERIOD_MS;
+			standInStream(pCreate);
+		}
+	}
+}
+
+size_t irobotCreateStandInTakeReply(irobotCreateStandIn_t * const pCreate, uint8_t * const bytes, const size_t maxBytes){
+	const size_t length = pCreate->replyLength < maxBytes ? pCreate->replyLength : maxBytes;
+
+	memcpy(bytes, pCreate->reply, length);
+	memmove(pCreate->reply, &pCreate->reply[length], pCreate->replyLength - length);
+	pCreate->replyLength -= length;
+	pCreate->bytesSent += length;
+
+	return length;
+}
+
+void irobotCreateStandInPrintStatistics(const irobotCreateStandIn_t * const pCreate){
+	printf("received %llu bytes in %u commands (%u unknown bytes)\n",
+			(unsigned long long)pCreate->bytesReceived,
+			pCreate->nCommands,
+			pCreate->nUnknownBytes);
+	printf("drive commands: %u, redundant: %u (%u bytes)\n",
+			pCreate->nDriveCommands,
+			pCreate->nRedundantDriveCommands,
+			pCreate->nRedundantDriveCommands * 5);
+	printf("sensor queries: %u, sent %llu bytes\n",
+			pCreate->nSensorQueries,
+			(unsigned long long)pCreate->bytesSent);
+	if(pCreate->nScriptPlays > 0){
+		printf("scripts: %u uploaded, %u played\n", pCreate->nScriptUploads, pCreate->nScriptPlays);
+	}
+	if(pCreate->nReactions > 0){
+		printf("obstacle reactions: %u, mean %.1f ms, max %u ms\n",
+				pCreate->nReactions,
+				(double)pCreate->reactionMsTotal / pCreate->nReactions,
+				pCreate->reactionMsMax);
+	}
+}
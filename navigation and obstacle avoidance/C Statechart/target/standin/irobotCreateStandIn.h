@@ -0,0 +1,135 @@
+/** \file irobotCreateStandIn.h
+ *
+ * Stand-in for the iRobot Create on the other end of the UART. Parses the
+ * Open Interface byte stream, answers sensor queries and streams, and
+ * drives a simple kinematic model of the robot in a walled room, or in a
+ * world from irobotWorld.h with obstacles and cliffs. Counts the bytes and
+ * commands it receives, so that UART traffic can be measured without a
+ * robot.
+ *
+ * Scripts are stored and played as on the Create: Wait Distance, Wait
+ * Angle and Wait Time hold the script on the robot's odometry and clock,
+ * and serial input received while a script plays is held until it ends. A
+ * wheel drop ends a script, as the safety features of safe mode would.
+ * Events are not modeled, so Wait Event does not wait.
+ *
+ * The reaction time to an obstacle is measured from the millisecond a
+ * bumper closes while the robot drives forward to the first drive command
+ * that slows it down.
+ */
+
+#ifndef IROBOTCREATESTANDIN_H_
+#define IROBOTCREATESTANDIN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "irobotOpenInterface.h"
+#include "irobotWorld.h"
+
+#define STANDIN_COMMAND_SIZE		256		///< longest Open Interface command, in bytes
+#define STANDIN_REPLY_SIZE			1024	///< reply bytes buffered for the host
+#define STANDIN_GROUP6_SIZE			52		///< sensor packet group 6, in bytes
+#define STANDIN_STREAM_PERIOD_MS	15		///< period of the sensor stream, in ms
+#define STANDIN_STREAM_IDS			16		///< largest number of packets in a stream
+#define STANDIN_HOLD_SIZE			1024	///< serial input held while a script plays, in bytes
+
+/// Stand-in Create
+typedef struct{
+	// open interface
+	uint8_t		command[STANDIN_COMMAND_SIZE];	///< command being received
+	uint32_t	commandLength;					///< bytes of command received
+	uint8_t		oiMode;							///< 0 off, 1 passive, 2 safe, 3 full
+	uint8_t		streamIds[STANDIN_STREAM_IDS];	///< streamed sensor packet ids
+	uint32_t	nStreamIds;						///< number of streamed packets; 0 if not streaming
+	bool		streamPaused;					///< stream paused by the host
+	uint32_t	msUntilStream;					///< time until the next stream packet, in ms
+
+	// script
+	uint8_t		script[OI_SCRIPT_MAX_SIZE];	///< uploaded script
+	uint32_t	scriptLength;					///< size of the script, in bytes
+	uint32_t	scriptPosition;					///< offset of the next script command, in bytes
+	bool		scriptPlaying;					///< a script is playing
+	uint8_t		waitOpcode;						///< wait the script is held in, or 0
+	double		waitRemaining;					///< distance, in mm, angle, in deg, or time, in ms, left to wait
+	bool		waitNegative;					///< waiting for a distance backward or a clockwise angle
+	uint8_t		held[STANDIN_HOLD_SIZE];		///< serial input received while the script plays
+	size_t		heldLength;						///< number of bytes in held
+
+	// reply to the host
+	uint8_t		reply[STANDIN_REPLY_SIZE];		///< bytes waiting to be read by the host
+	size_t		replyLength;					///< number of bytes in reply
+
+	// robot model
+	int16_t		leftWheelSpeed;					///< commanded left wheel speed, in mm/s
+	int16_t		rightWheelSpeed;				///< commanded right wheel speed, in mm/s
+	double		x;								///< position, in mm
+	double		y;								///< position, in mm
+	double		heading;						///< heading, counter-clockwise from +x, in rad
+	double		distance;						///< distance since the last sensor packet, in mm
+	double		angle;							///< angle since the last sensor packet, in deg
+	double		roomSize;						///< side of the square room, centered on the origin, in mm
+	const irobotWorld_t *	pWorld;				///< obstacles and cliffs in the room, or NULL for an empty room
+	bool		bumpLeft;						///< left bumper pressed
+	bool		bumpRight;						///< right bumper pressed
+	bool		wheelDrop;						///< the robot has driven over a cliff; the wheels have dropped
+	bool		buttonPlay;						///< play button pressed
+	bool		buttonAdvance;					///< advance button pressed
+
+	// statistics
+	uint64_t	bytesReceived;					///< bytes received from the host
+	uint64_t	bytesSent;						///< bytes sent to the host
+	uint32_t	nCommands;						///< commands received
+	uint32_t	nDriveCommands;					///< drive commands received
+	uint32_t	nRedundantDriveCommands;		///< drive commands that did not change the wheel speeds
+	uint32_t	nSensorQueries;					///< sensor queries answered
+	uint32_t	nUnknownBytes;					///< bytes that did not start a known command
+	uint32_t	nScriptUploads;					///< scripts received
+	uint32_t	nScriptPlays;					///< scripts played
+	bool		reactionPending;				///< the bumper closed while driving forward, and the host has not yet slowed down
+	double		reactionSpeed;					///< forward speed when the bumper closed, in mm/s
+	uint32_t	reactionMs;						///< time since the bumper closed, in ms
+	uint32_t	nReactions;						///< obstacles the host reacted to
+	uint64_t	reactionMsTotal;				///< sum of the reaction times, in ms
+	uint32_t	reactionMsMax;					///< longest reaction time, in ms
+} irobotCreateStandIn_t;
+
+/// Initialize the stand-in at the center of a room, stopped and in passive mode.
+void irobotCreateStandInInit(
+	irobotCreateStandIn_t * const	pCreate,	///< [out] stand-in
+	const double					roomSize	///< [in] side of the square room, in mm
+);
+
+/// Place the stand-in at the start of a world. The world must outlive the stand-in.
+void irobotCreateStandInSetWorld(
+	irobotCreateStandIn_t * const	pCreate,	///< [in,out] stand-in
+	const irobotWorld_t * const		pWorld		///< [in] world
+);
+
+/// Process bytes written by the host.
+void irobotCreateStandInReceive(
+	irobotCreateStandIn_t * const	pCreate,	///< [in,out] stand-in
+	const uint8_t * const			bytes,		///< [in] bytes from the host
+	const size_t					nBytes		///< [in] number of bytes
+);
+
+/// Advance the robot model and the sensor stream.
+void irobotCreateStandInAdvance(
+	irobotCreateStandIn_t * const	pCreate,	///< [in,out] stand-in
+	const uint32_t					ms			///< [in] elapsed time, in ms
+);
+
+/// Take bytes to be sent to the host.
+/// \returns number of bytes copied
+size_t irobotCreateStandInTakeReply(
+	irobotCreateStandIn_t * const	pCreate,	///< [in,out] stand-in
+	uint8_t * const					bytes,		///< [out] bytes for the host
+	const size_t					maxBytes	///< [in] size of bytes
+);
+
+/// Print the traffic statistics.
+void irobotCreateStandInPrintStatistics(
+	const irobotCreateStandIn_t * const	pCreate	///< [in] stand-in
+);
+
+#endif // IROBOTCREATESTANDIN_H_
@@ -0,0 +1,134 @@
+/** \file irobotWorld.c
+ *
+ * World packs: mapping, header checks and world lookup (Linux).
+ */
+
+#include "irobotWorld.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char * const kindNames[IROBOT_WORLD_KINDS] = {
+	[IROBOT_WORLD_KIND_ROOM] = "room",
+	[IROBOT_WORLD_KIND_MAZE] = "maze",
+	[IROBOT_WORLD_KIND_CLIFFS] = "cliffs",
+	[IROBOT_WORLD_KIND_RAMPS] = "ramps",
+};
+
+/// \returns true if [offset, offset + size) lies within a block of total bytes
+static bool worldWithin(const uint64_t offset, const uint64_t size, const uint64_t total){
+	return offset <= total && size <= total - offset;
+}
+
+bool irobotWorldPackAttach(irobotWorldPack_t * const pPack, const void * const bytes, const size_t size){
+	const irobotWorldPackHeader_t * const pHeader = (const irobotWorldPackHeader_t*)bytes;
+
+	memset(pPack, 0, sizeof(*pPack));
+	if(size < sizeof(*pHeader) || memcmp(pHeader->magic, IROBOT_WORLD_MAGIC, sizeof(pHeader->magic)) != 0){
+		fprintf(stderr, "world pack: not a world pack\n");
+		return false;
+	}
+	if(pHeader->byteOrder != IROBOT_WORLD_BYTE_ORDER){
+		fprintf(stderr, "world pack: written on a host of the other byte order\n");
+		return false;
+	}
+	if(pHeader->version != IROBOT_WORLD_VERSION){
+		fprintf(stderr, "world pack: version %u, expected %u\n", pHeader->version, IROBOT_WORLD_VERSION);
+		return false;
+	}
+	if(pHeader->tableOffset % sizeof(uint64_t) != 0
+	   || !worldWithin(pHeader->tableOffset, (uint64_t)pHeader->nWorlds * sizeof(irobotWorldPackEntry_t), size)
+	){
+		fprintf(stderr, "world pack: truncated world table\n");
+		return false;
+	}
+
+	pPack->bytes = (const uint8_t*)bytes;
+	pPack->size = size;
+	pPack->nWorlds = pHeader->nWorlds;
+	return true;
+}
+
+bool irobotWorldPackOpen(irobotWorldPack_t * const pPack, const char * const path){
+	struct stat		st;
+	void *			bytes;
+	int				fd;
+
+	memset(pPack, 0, sizeof(*pPack));
+	fd = open(path, O_RDONLY);
+	if(fd < 0 || fstat(fd, &st) != 0){
+		perror("world pack: open");
+		if(fd >= 0){
+			close(fd);
+		}
+		return false;
+	}
+	if(st.st_size == 0){
+		fprintf(stderr, "world pack: %s is empty\n", path);
+		close(fd);
+		return false;
+	}
+
+	// the mapping outlives the descriptor
+	bytes = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(bytes == MAP_FAILED){
+		perror("world pack: mmap");
+		return false;
+	}
+
+	if(!irobotWorldPackAttach(pPack, bytes, (size_t)st.st_size)){
+		munmap(bytes, (size_t)st.st_size);
+		return false;
+	}
+	pPack->mapped = true;
+	return true;
+}
+
+void irobotWorldPackClose(irobotWorldPack_t * const pPack){
+	if(pPack->mapped){
+		munmap((void*)pPack->bytes, pPack->size);
+	}
+	memset(pPack, 0, sizeof(*pPack));
+}
+
+bool irobotWorldPackGet(const irobotWorldPack_t * const pPack, const uint32_t index, irobotWorld_t * const pWorld){
+	const irobotWorldPackHeader_t *	pPackHeader = (const irobotWorldPackHeader_t*)pPack->bytes;
+	const irobotWorldPackEntry_t *	pEntry;
+	const irobotWorldHeader_t *		pHeader;
+
+	if(index >= pPack->nWorlds){
+		return false;
+	}
+	pEntry = (const irobotWorldPackEntry_t*)(pPack->bytes + pPackHeader->tableOffset) + index;
+	if(pEntry->offset % IROBOT_WORLD_ALIGNMENT != 0
+	   || !worldWithin(pEntry->offset, pEntry->size, pPack->size)
+	   || pEntry->size < sizeof(*pHeader)
+	){
+		return false;
+	}
+
+	pHeader = (const irobotWorldHeader_t*)(pPack->bytes + pEntry->offset);
+	if(!(pHeader->cellSize > 0)
+	   || pHeader->nRamps > IROBOT_WORLD_RAMPS
+	   || pHeader->rampsOffset % sizeof(float) != 0
+	   || !worldWithin(pHeader->rampsOffset, (uint64_t)pHeader->nRamps * sizeof(irobotWorldRamp_t), pEntry->size)
+	   || !worldWithin(pHeader->cellsOffset, (uint64_t)pHeader->cellsPerSide * pHeader->cellsPerSide, pEntry->size)
+	){
+		return false;
+	}
+
+	pWorld->pHeader = pHeader;
+	pWorld->ramps = (const irobotWorldRamp_t*)((const uint8_t*)pHeader + pHeader->rampsOffset);
+	pWorld->cells = (const uint8_t*)pHeader + pHeader->cellsOffset;
+	pWorld->half = pHeader->roomSize / 2;
+	pWorld->cellsPerMm = 1 / pHeader->cellSize;
+	return true;
+}
+
+const char * irobotWorldKindName(const uint32_t kind){
+	return kind < IROBOT_WORLD_KINDS ? kindNames[kind] : "unknown";
+}
@@ -0,0 +1,160 @@
+/** \file irobotWorld.h
+ *
+ * Test worlds for the stand-in: walls, cliffs and ramps on a grid over a
+ * square room centered on the origin. Worlds are generated by the worldgen
+ * target into a world pack, a versioned binary file that is memory-mapped
+ * and used in place: opening a pack checks its header, and fetching a
+ * world checks that its extent lies within the file. Nothing is parsed or
+ * copied, so a worker can switch worlds in microseconds.
+ *
+ * Pack layout, in host byte order, every world aligned to 64 bytes:
+ *
+ *	irobotWorldPackHeader_t
+ *	irobotWorldPackEntry_t		[nWorlds]
+ *	world 0:	irobotWorldHeader_t
+ *				irobotWorldRamp_t	[nRamps]	at rampsOffset
+ *				uint8_t				[cellsPerSide * cellsPerSide]	at cellsOffset, row by row from -y
+ *	world 1:	...
+ *
+ * A cell holds IROBOT_WORLD_FLOOR, IROBOT_WORLD_WALL, IROBOT_WORLD_CLIFF,
+ * or IROBOT_WORLD_RAMP plus the index of a ramp. Change
+ * IROBOT_WORLD_VERSION whenever the layout changes; older packs are then
+ * refused rather than misread.
+ */
+
+#ifndef IROBOTWORLD_H_
+#define IROBOTWORLD_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define IROBOT_WORLD_MAGIC		"IRWP"		///< first bytes of a world pack
+#define IROBOT_WORLD_VERSION	1			///< layout version
+#define IROBOT_WORLD_BYTE_ORDER	0x0102		///< written in host order; reads back swapped on a host of the other order
+#define IROBOT_WORLD_ALIGNMENT	64			///< alignment of each world in the pack, in bytes
+
+// cell values
+#define IROBOT_WORLD_FLOOR		0			///< level floor
+#define IROBOT_WORLD_WALL		1			///< obstacle; presses the bumpers and is seen by the wall sensor
+#define IROBOT_WORLD_CLIFF		2			///< drop; seen by the cliff sensors, drops the wheels
+#define IROBOT_WORLD_RAMP		3			///< first ramp; IROBOT_WORLD_RAMP + i is ramp i
+#define IROBOT_WORLD_RAMPS		(256 - IROBOT_WORLD_RAMP)	///< largest number of ramps in a world
+
+/// Kind of world, as generated
+typedef enum{
+	IROBOT_WORLD_KIND_ROOM,					///< room with box obstacles
+	IROBOT_WORLD_KIND_MAZE,					///< maze of corridors
+	IROBOT_WORLD_KIND_CLIFFS,				///< room with drops
+	IROBOT_WORLD_KIND_RAMPS,				///< room with ramps around the hill-climb thresholds
+	IROBOT_WORLD_KINDS
+} irobotWorldKind_t;
+
+/// Pack header
+typedef struct{
+	char		magic[4];					///< IROBOT_WORLD_MAGIC
+	uint16_t	version;					///< IROBOT_WORLD_VERSION
+	uint16_t	byteOrder;					///< IROBOT_WORLD_BYTE_ORDER
+	uint32_t	nWorlds;					///< number of worlds
+	uint32_t	reserved;					///< 0
+	uint64_t	tableOffset;				///< offset of the world table, in bytes
+} irobotWorldPackHeader_t;
+
+/// World table entry
+typedef struct{
+	uint64_t	offset;						///< offset of the world from the start of the pack, in bytes
+	uint64_t	size;						///< size of the world, in bytes
+} irobotWorldPackEntry_t;
+
+/// World header
+typedef struct{
+	uint32_t	kind;						///< irobotWorldKind_t
+	uint32_t	seed;						///< generator seed
+	float		roomSize;					///< side of the room, in mm
+	float		cellSize;					///< side of a cell, in mm
+	uint32_t	cellsPerSide;				///< cells per side of the room
+	uint32_t	nRamps;						///< number of ramps
+	uint32_t	rampsOffset;				///< offset of the ramps from the world header, in bytes
+	uint32_t	cellsOffset;				///< offset of the cells from the world header, in bytes
+	float		startX;						///< start position, in mm
+	float		startY;						///< start position, in mm
+	float		startHeading;				///< start heading, counter-clockwise from +x, in rad
+	uint32_t	reserved;					///< 0
+} irobotWorldHeader_t;
+
+/// Ramp; a plane rising in one direction
+typedef struct{
+	float		inclination;				///< angle of the surface, in deg
+	float		uphill;						///< direction of steepest ascent, counter-clockwise from +x, in rad
+} irobotWorldRamp_t;
+
+/// World in a pack
+typedef struct{
+	const irobotWorldHeader_t *	pHeader;	///< header
+	const irobotWorldRamp_t *	ramps;		///< ramps
+	const uint8_t *				cells;		///< cells, row by row from -y
+	float						half;		///< half the room size, in mm
+	float						cellsPerMm;	///< inverse of the cell size
+} irobotWorld_t;
+
+/// Memory-mapped world pack
+typedef struct{
+	const uint8_t *				bytes;		///< pack
+	size_t						size;		///< size of the pack, in bytes
+	uint32_t					nWorlds;	///< number of worlds
+	bool						mapped;		///< bytes is a mapping owned by the pack
+} irobotWorldPack_t;
+
+/// Map a world pack file and check its header.
+/// \returns false, with a message on stderr, if the file cannot be mapped or is not a pack of this version
+bool irobotWorldPackOpen(
+	irobotWorldPack_t * const		pPack,		///< [out] pack
+	const char * const				path		///< [in] pack file
+);
+
+/// Use a world pack already in memory, e.g. as written by the generator.
+/// \returns false, with a message on stderr, if the bytes are not a pack of this version
+bool irobotWorldPackAttach(
+	irobotWorldPack_t * const		pPack,		///< [out] pack
+	const void * const				bytes,		///< [in] pack, aligned to IROBOT_WORLD_ALIGNMENT; must outlive the pack
+	const size_t					size		///< [in] size of the pack, in bytes
+);
+
+/// Unmap a pack opened with irobotWorldPackOpen().
+void irobotWorldPackClose(
+	irobotWorldPack_t * const		pPack		///< [in,out] pack
+);
+
+/// Fetch a world from a pack.
+/// \returns false if the index is out of range or the world does not lie within the pack
+bool irobotWorldPackGet(
+	const irobotWorldPack_t * const	pPack,		///< [in] pack
+	const uint32_t					index,		///< [in] world index
+	irobotWorld_t * const			pWorld		///< [out] world, pointing into the pack
+);
+
+/// Name of a world kind.
+const char * irobotWorldKindName(
+	const uint32_t					kind		///< [in] irobotWorldKind_t
+);
+
+/// \returns cell at a position; IROBOT_WORLD_WALL outside the room
+static inline uint8_t irobotWorldCell(const irobotWorld_t * const pWorld, const double x, const double y){
+	const double column = (x + pWorld->half) * pWorld->cellsPerMm;
+	const double row = (y + pWorld->half) * pWorld->cellsPerMm;
+
+	if(!(column >= 0 && row >= 0 && column < pWorld->pHeader->cellsPerSide && row < pWorld->pHeader->cellsPerSide)){
+		return IROBOT_WORLD_WALL;
+	}
+	return pWorld->cells[(size_t)row * pWorld->pHeader->cellsPerSide + (size_t)column];
+}
+
+/// \returns ramp at a position, or NULL on level ground
+static inline const irobotWorldRamp_t * irobotWorldRampAt(const irobotWorld_t * const pWorld, const double x, const double y){
+	const uint32_t ramp = (uint32_t)irobotWorldCell(pWorld, x, y) - IROBOT_WORLD_RAMP;
+
+	// cells are not checked when a world is fetched, so an unknown ramp is level
+	return ramp < pWorld->pHeader->nRamps ? &pWorld->ramps[ramp] : NULL;
+}
+
+#endif // IROBOTWORLD_H_
@@ -0,0 +1,188 @@
+/** \file main.c
+ *
+ * Runs the stand-in iRobot Create on a pseudo-terminal, so that a host
+ * application can be pointed at the printed device instead of a serial
+ * port. Traffic statistics are printed on exit. Every byte sent to the host
+ * can be recorded to a capture file, for the capture target to analyze.
+ *
+ * Build (Linux), from this directory:
+ *	gcc -O2 -I../.. -o standin main.c irobotCreateStandIn.c irobotWorld.c -lm
+ *
+ * Usage:
+ *	standin [room size, in mm | world pack[:world]] [capture file]
+ *
+ * A world pack written by the worldgen target replaces the empty room
+ * with one of its worlds, the first unless another is given.
+ *
+ * Keys on stdin (followed by enter): p presses play, a presses advance,
+ * q quits.
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "irobotCreateStandIn.h"
+
+static const uint64_t buttonPressMs = 200;		// how long a key holds a button down, in ms
+static const double defaultRoomSize = 4000;		// side of the room, in mm
+
+static volatile sig_atomic_t quit = 0;
+
+static void onSignal(int signal){
+	(void)signal;
+	quit = 1;
+}
+
+static uint64_t getTimeInMs(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/// Open a pseudo-terminal in raw mode.
+/// \returns master file descriptor, or -1
+static int openPty(void){
+	struct termios	tio;
+	int				master;
+
+	master = posix_openpt(O_RDWR | O_NOCTTY);
+	if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0){
+		perror("standin: posix_openpt");
+		return -1;
+	}
+
+	// Open Interface bytes are binary; no line discipline on the host side
+	if(tcgetattr(master, &tio) == 0){
+		cfmakeraw(&tio);
+		tcsetattr(master, TCSANOW, &tio);
+	}
+	return master;
+}
+
+int main(int argc, char **argv)
+{
+	irobotCreateStandIn_t	create;
+	struct pollfd			fds[2];
+	uint8_t					bytes[STANDIN_REPLY_SIZE];
+	uint64_t				msNow;
+	uint64_t				msPlayReleased = 0;
+	uint64_t				msAdvanceReleased = 0;
+	FILE *					capture = NULL;
+	irobotWorldPack_t		pack;
+	irobotWorld_t			world;
+	char *					end = NULL;
+	int						master;
+
+	irobotCreateStandInInit(&create, argc > 1 ? strtod(argv[1], &end) : defaultRoomSize);
+	if(argc > 1 && (end == argv[1] || *end != '\0')){
+		// not a number; a world pack
+		char * const	separator = strrchr(argv[1], ':');
+		uint32_t		index = 0;
+
+		if(separator){
+			*separator = '\0';
+			index = (uint32_t)strtoul(separator + 1, NULL, 10);
+		}
+		if(!irobotWorldPackOpen(&pack, argv[1]) || !irobotWorldPackGet(&pack, index, &world)){
+			fprintf(stderr, "standin: no world %u in %s\n", index, argv[1]);
+			return EXIT_FAILURE;
+		}
+		irobotCreateStandInSetWorld(&create, &world);
+		printf("world %u: %s, seed %u\n", index, irobotWorldKindName(world.pHeader->kind), world.pHeader->seed);
+	}
+
+	if(argc > 2){
+		capture = fopen(argv[2], "wb");
+		if(!capture){
+			perror("standin: fopen");
+			return EXIT_FAILURE;
+		}
+	}
+
+	master = openPty();
+	if(master < 0){
+		return EXIT_FAILURE;
+	}
+	printf("iRobot Create stand-in on %s\n", ptsname(master));
+	fflush(stdout);
+
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+
+	fds[0].fd = master;
+	fds[0].events = POLLIN;
+	fds[1].fd = STDIN_FILENO;
+	fds[1].events = POLLIN;
+
+	msNow = getTimeInMs();
+	while(!quit){
+		uint64_t	msElapsed;
+		ssize_t		nBytes;
+		size_t		nReply;
+
+		if(poll(fds, 2, 1) < 0 && errno != EINTR){
+			perror("standin: poll");
+			break;
+		}
+
+		// bytes from the host
+		if(fds[0].revents & POLLIN){
+			nBytes = read(master, bytes, sizeof(bytes));
+			if(nBytes > 0){
+				irobotCreateStandInReceive(&create, bytes, (size_t)nBytes);
+			}
+		}
+		else if(fds[0].revents & POLLHUP){
+			// no host has the device open; poll() would not block
+			usleep(1000);
+		}
+
+		if(fds[1].revents & POLLIN){
+			char key = 0;
+			if(read(STDIN_FILENO, &key, 1) == 1){
+				if(key == 'p'){
+					msPlayReleased = msNow + buttonPressMs;
+				}
+				else if(key == 'a'){
+					msAdvanceReleased = msNow + buttonPressMs;
+				}
+				else if(key == 'q'){
+					quit = 1;
+				}
+			}
+			else{
+				fds[1].fd = -1;		// stdin closed; keep running until a signal
+			}
+		}
+
+		msElapsed = getTimeInMs() - msNow;
+		msNow += msElapsed;
+		create.buttonPlay = msNow < msPlayReleased;
+		create.buttonAdvance = msNow < msAdvanceReleased;
+		irobotCreateStandInAdvance(&create, (uint32_t)msElapsed);
+
+		nReply = irobotCreateStandInTakeReply(&create, bytes, sizeof(bytes));
+		if(nReply > 0 && write(master, bytes, nReply) < 0 && errno != EIO){
+			perror("standin: write");
+		}
+		if(nReply > 0 && capture){
+			fwrite(bytes, 1, nReply, capture);
+		}
+	}
+
+	irobotCreateStandInPrintStatistics(&create);
+	if(capture){
+		fclose(capture);
+	}
+	close(master);
+
+	return EXIT_SUCCESS;
+}
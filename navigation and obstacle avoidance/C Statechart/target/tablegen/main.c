@@ -0,0 +1,291 @@
+/** \file main.c
+ *
+ * Compiles irobotNavStatechart.c into the lookup table used by
+ * irobotNavTableStatechart.c. Every (discrete state, input bitmask) pair is
+ * executed once against the original statechart, through its context
+ * functions, and the next state, latches and outputs are recorded.
+ *
+ * Build (Linux), from this directory:
+ *	gcc -O2 -I../.. -I../../.. -I../../../irobot -o tablegen main.c
+ *		../../../irobotNavStatechart.c -lm
+ *
+ * Usage:
+ *	tablegen > ../../../irobotNavStatechartTableData.h
+ *	tablegen --verify [ticks]
+ *
+ * --verify checks that irobotNavStatechartTableData.h, as compiled in, is
+ * the table generated from the linked statechart, then runs the table and
+ * the statechart side by side on random inputs and compares their outputs
+ * and contexts every tick.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "irobotNavigationStatechart.h"
+#include "irobotNavStatechartTable.h"
+#include "irobotNavStatechartTableData.h"
+
+#define DEFAULT_TICKS		10000000	///< ticks compared by --verify
+#define MANEUVER_START		1000		///< maneuver start recorded in each enumerated context
+
+static navTableEntry_t		generatedTable[NAVTABLE_STATES][NAVTABLE_INPUTS];
+static navTableOutput_t		generatedOutputs[NAVTABLE_OUTPUTS];
+static uint32_t				nGeneratedOutputs = 0;
+
+static uint64_t				randomState = 0x9E3779B97F4A7C15ULL;
+
+/// xorshift64; deterministic so that failures can be reproduced
+static uint32_t randomNext(void){
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 7;
+	randomState ^= randomState << 17;
+	return (uint32_t)(randomState >> 32);
+}
+
+/// \returns true with probability 1/n
+static bool randomOneIn(const uint32_t n){
+	return randomNext() % n == 0;
+}
+
+/// Save the statechart context.
+/// \returns false if it is not a context this table can represent
+static bool contextSave(navTableContext_t * const pContext){
+	return irobotNavigationStatechartContextSave(pContext, sizeof(*pContext)) == sizeof(*pContext)
+		&& pContext->tag == NAVTABLE_CONTEXT_TAG;
+}
+
+/// \returns index of an output in the generated output table, adding it if new
+static int32_t outputIndex(const navTableOutput_t output){
+	uint32_t i;
+
+	for(i = 0; i < nGeneratedOutputs; i++){
+		if(	  generatedOutputs[i].leftWheelSpeed == output.leftWheelSpeed
+		   && generatedOutputs[i].rightWheelSpeed == output.rightWheelSpeed
+		   && generatedOutputs[i].periodMs == output.periodMs
+		){
+			return (int32_t)i;
+		}
+	}
+	if(nGeneratedOutputs == NAVTABLE_OUTPUTS){
+		return -1;
+	}
+	generatedOutputs[nGeneratedOutputs] = output;
+	return (int32_t)nGeneratedOutputs++;
+}
+
+/// Execute the statechart once for every discrete state and input bitmask.
+/// \returns false if the statechart does something the table cannot represent
+static bool generate(void){
+	const accelerometer_t	accel = {0, 0, 1};
+	uint32_t				index;
+	uint32_t				inputs;
+
+	for(index = 0; index < NAVTABLE_STATES; index++){
+		for(inputs = 0; inputs < NAVTABLE_INPUTS; inputs++){
+			navTableContext_t		context;
+			navTableOutput_t		output;
+			irobotSensorGroup6_t	sensors;
+			int32_t					netDistance;
+			int32_t					netAngle;
+			int32_t					action;
+			uint32_t				next;
+
+			context.tag = NAVTABLE_CONTEXT_TAG;
+			navTableStateFromIndex(index, &context.state, &context.unpausedState, &context.obstacleDirection);
+			context.distanceAtManeuverStart = MANEUVER_START;
+			context.angleAtManeuverStart = MANEUVER_START;
+			if(!irobotNavigationStatechartContextRestore(&context, sizeof(context))){
+				fprintf(stderr, "tablegen: statechart rejected the context of state %u\n", index);
+				return false;
+			}
+
+			// inputs that satisfy exactly the bits of the mask; distance and
+			// angle differ from the maneuver start, so that latches show
+			memset(&sensors, 0, sizeof(sensors));
+			sensors.buttons.play = (inputs & NAVTABLE_INPUT_PLAY) != 0;
+			sensors.bumps_wheelDrops.bumpLeft = (inputs & NAVTABLE_INPUT_OBSTACLE_LEFT) != 0;
+			sensors.bumps_wheelDrops.bumpRight = (inputs & NAVTABLE_INPUT_OBSTACLE_RIGHT) != 0;
+			netDistance = MANEUVER_START + (inputs & NAVTABLE_INPUT_AVOID_DONE ? NAVTABLE_AVOID_DISTANCE : NAVTABLE_AVOID_DISTANCE / 2);
+			netAngle = inputs & NAVTABLE_INPUT_REORIENTED ? 1 : NAVTABLE_REORIENT_TOLERANCE + 1;
+			netAngle = MANEUVER_START + (inputs & NAVTABLE_INPUT_TURN_LEFT ? -netAngle : netAngle);
+
+			output.periodMs = irobotNavigationStatechart(netDistance, netAngle, sensors, accel, true,
+				&output.rightWheelSpeed, &output.leftWheelSpeed);
+
+			if(!contextSave(&context)){
+				fprintf(stderr, "tablegen: statechart context is not \"NAV1\"\n");
+				return false;
+			}
+			next = navTableStateIndex(context.state, context.unpausedState, context.obstacleDirection);
+			action = outputIndex(output);
+			if(next >= NAVTABLE_STATES || action < 0){
+				fprintf(stderr, "tablegen: state %u, inputs 0x%02X: %s\n", index, inputs,
+					action < 0 ? "too many distinct outputs" : "unreachable next state");
+				return false;
+			}
+
+			if(context.distanceAtManeuverStart == netDistance){
+				action |= NAVTABLE_ACTION_LATCH_DISTANCE;
+			}
+			else if(context.distanceAtManeuverStart != MANEUVER_START){
+				fprintf(stderr, "tablegen: state %u, inputs 0x%02X: distance latch is not the net distance\n", index, inputs);
+				return false;
+			}
+			if(context.angleAtManeuverStart == netAngle){
+				action |= NAVTABLE_ACTION_LATCH_ANGLE;
+			}
+			else if(context.angleAtManeuverStart != MANEUVER_START){
+				fprintf(stderr, "tablegen: state %u, inputs 0x%02X: angle latch is not the net angle\n", index, inputs);
+				return false;
+			}
+
+			generatedTable[index][inputs].next = (uint8_t)next;
+			generatedTable[index][inputs].action = (uint8_t)action;
+		}
+	}
+	return true;
+}
+
+/// Write the generated table as irobotNavStatechartTableData.h.
+static void emit(void){
+	uint32_t index;
+	uint32_t inputs;
+
+	printf("/*\n");
+	printf(" *\tirobotNavStatechartTableData.h\n");
+	printf(" *\n");
+	printf(" *\tGenerated by target/tablegen from irobotNavStatechart.c; do not edit.\n");
+	printf(" *\tEntries are {next state, action}, indexed by state and input bitmask.\n");
+	printf(" *\n");
+	printf(" */\n\n");
+	printf("#ifndef IROBOTNAVSTATECHARTTABLEDATA_H_\n");
+	printf("#define IROBOTNAVSTATECHARTTABLEDATA_H_\n\n");
+	printf("#include \"irobotNavStatechartTable.h\"\n\n");
+
+	printf("static const navTableOutput_t navTableOutputs[NAVTABLE_OUTPUTS] = {\n");
+	for(index = 0; index < nGeneratedOutputs; index++){
+		printf("\t{%d, %d, %u},\n", generatedOutputs[index].leftWheelSpeed,
+			generatedOutputs[index].rightWheelSpeed, generatedOutputs[index].periodMs);
+	}
+	printf("};\n\n");
+
+	printf("static const navTableEntry_t navTable[NAVTABLE_STATES][NAVTABLE_INPUTS] = {\n");
+	for(index = 0; index < NAVTABLE_STATES; index++){
+		uint32_t state;
+		uint32_t unpausedState;
+		uint32_t obstacleDirection;
+
+		navTableStateFromIndex(index, &state, &unpausedState, &obstacleDirection);
+		printf("\t{\t// %u: state %u, unpaused %u, direction %u\n", index, state, unpausedState, obstacleDirection);
+		for(inputs = 0; inputs < NAVTABLE_INPUTS; inputs++){
+			printf("%s{%2u,0x%02X},%s", inputs % 8 == 0 ? "\t\t" : "",
+				generatedTable[index][inputs].next, generatedTable[index][inputs].action,
+				inputs % 8 == 7 ? "\n" : " ");
+		}
+		printf("\t},\n");
+	}
+	printf("};\n\n");
+	printf("#endif // IROBOTNAVSTATECHARTTABLEDATA_H_\n");
+}
+
+/// Random inputs that cross the thresholds and toggle buttons and obstacles often.
+static void randomInputs(int32_t * const pNetDistance, int32_t * const pNetAngle, irobotSensorGroup6_t * const pSensors){
+	memset(pSensors, 0, sizeof(*pSensors));
+	pSensors->buttons.play = randomOneIn(6);
+	pSensors->bumps_wheelDrops.bumpLeft = randomOneIn(24);
+	pSensors->bumps_wheelDrops.bumpRight = randomOneIn(24);
+	pSensors->bumps_wheelDrops.wheeldropLeft = randomOneIn(48);
+	pSensors->bumps_wheelDrops.wheeldropRight = randomOneIn(48);
+	pSensors->cliffLeft = randomOneIn(48);
+	pSensors->cliffFrontLeft = randomOneIn(48);
+	pSensors->cliffFrontRight = randomOneIn(48);
+	pSensors->cliffRight = randomOneIn(48);
+	pSensors->wall = randomOneIn(8);
+
+	// small steps, so that distance and angle pass through the thresholds
+	*pNetDistance += (int32_t)(randomNext() % 61) - 20;
+	*pNetAngle += (int32_t)(randomNext() % 7) - 3;
+	if(randomOneIn(1000)){
+		*pNetAngle += (int32_t)(randomNext() % 720) - 360;
+	}
+}
+
+/// Compare the compiled-in table with the generated one, then run both side by side.
+/// \returns true if they agree
+static bool verify(const uint32_t nTicks){
+	const accelerometer_t	accel = {0, 0, 1};
+	navTableState_t			tableState = {0, 0, 0};
+	navTableContext_t		context;
+	int32_t					netDistance = 0;
+	int32_t					netAngle = 0;
+	uint32_t				stateTicks[NAVTABLE_STATES] = {0};
+	uint32_t				nStatesVisited = 0;
+	uint32_t				tick;
+
+	if(	  memcmp(navTable, generatedTable, sizeof(navTable)) != 0
+	   || memcmp(navTableOutputs, generatedOutputs, sizeof(navTableOutputs)) != 0
+	){
+		fprintf(stderr, "tablegen: irobotNavStatechartTableData.h is stale; regenerate it\n");
+		return false;
+	}
+
+	// both start in INITIAL
+	context.tag = NAVTABLE_CONTEXT_TAG;
+	navTableStateFromIndex(0, &context.state, &context.unpausedState, &context.obstacleDirection);
+	context.distanceAtManeuverStart = 0;
+	context.angleAtManeuverStart = 0;
+	irobotNavigationStatechartContextRestore(&context, sizeof(context));
+
+	for(tick = 0; tick < nTicks; tick++){
+		irobotSensorGroup6_t	sensors;
+		int16_t					leftWheelSpeed;
+		int16_t					rightWheelSpeed;
+		int16_t					tableLeftWheelSpeed;
+		int16_t					tableRightWheelSpeed;
+		uint32_t				periodMs;
+		uint32_t				tablePeriodMs;
+
+		randomInputs(&netDistance, &netAngle, &sensors);
+		periodMs = irobotNavigationStatechart(netDistance, netAngle, sensors, accel, true, &rightWheelSpeed, &leftWheelSpeed);
+		tablePeriodMs = navTableStep(navTable, navTableOutputs, &tableState, netDistance, netAngle, sensors,
+			&tableRightWheelSpeed, &tableLeftWheelSpeed);
+
+		if(	  !contextSave(&context)
+		   || navTableStateIndex(context.state, context.unpausedState, context.obstacleDirection) != tableState.index
+		   || context.distanceAtManeuverStart != tableState.distanceAtManeuverStart
+		   || context.angleAtManeuverStart != tableState.angleAtManeuverStart
+		   || leftWheelSpeed != tableLeftWheelSpeed
+		   || rightWheelSpeed != tableRightWheelSpeed
+		   || periodMs != tablePeriodMs
+		){
+			fprintf(stderr, "tablegen: tick %u: statechart (%d, %d, %u ms) and table (%d, %d, %u ms) disagree\n",
+				tick, leftWheelSpeed, rightWheelSpeed, periodMs,
+				tableLeftWheelSpeed, tableRightWheelSpeed, tablePeriodMs);
+			return false;
+		}
+
+		if(stateTicks[tableState.index]++ == 0){
+			nStatesVisited++;
+		}
+	}
+
+	printf("tablegen: %u ticks agree; %u of %u states visited; table is %u bytes\n",
+		nTicks, nStatesVisited, NAVTABLE_STATES, (unsigned)(sizeof(navTable) + sizeof(navTableOutputs)));
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	if(!generate()){
+		return EXIT_FAILURE;
+	}
+
+	if(argc > 1 && strcmp(argv[1], "--verify") == 0){
+		return verify(argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : DEFAULT_TICKS) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	emit();
+	return EXIT_SUCCESS;
+}
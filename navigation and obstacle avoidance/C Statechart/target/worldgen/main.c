@@ -0,0 +1,471 @@
+/** \file main.c
+ *
+ * Generates test worlds for the stand-in into a world pack (irobotWorld.h),
+ * and inspects packs. Worlds cycle through the kinds, or are all of one
+ * kind with -k:
+ *
+ *	room		box obstacles in an empty room
+ *	maze		corridors one meter wide
+ *	cliffs		drops that trip the cliff sensors and the wheel drops
+ *	ramps		ramps from 2 to 10 deg, either side of the hill-climb
+ *				thresholds; irobotHillClimbStatechart.c measures an
+ *				inclination of about 90 sin(angle), so levelThreshold is
+ *				crossed near 4.5 deg and hillThreshold near 6.4 deg
+ *
+ * World i is generated from seed + i, so any world can be reproduced on
+ * its own. The start position is always clear.
+ *
+ * Build (Linux), from this directory:
+ *	gcc -O2 -I../standin -o worldgen main.c ../standin/irobotWorld.c -lm
+ *
+ * Usage:
+ *	worldgen [-n worlds] [-s seed] [-r room size, in mm] [-c cell size, in mm] [-k kind] <pack file>
+ *	worldgen -i [-x world -o image.pgm] <pack file>
+ *
+ * -i maps the pack, fetches every world and prints the time taken, and
+ * counts of each kind; -x with -o also writes one world as an image.
+ */
+
+#define _GNU_SOURCE
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "irobotWorld.h"
+
+static const uint32_t	defaultWorlds = 1000;		// worlds in a pack
+static const uint32_t	defaultSeed = 1;			// seed of the first world
+static const double		defaultRoomSize = 4000;		// side of the room, in mm
+static const double		defaultCellSize = 25;		// side of a cell, in mm
+static const double		startClearance = 400;		// radius kept clear around the start, in mm
+static const double		corridorWidth = 1000;		// maze corridor, wall to wall, in mm
+static const double		mazeWallWidth = 100;		// maze wall, in mm
+static const double		minInclination = 2;			// shallowest ramp, in deg
+static const double		maxInclination = 10;		// steepest ramp, in deg
+
+/// World being generated
+typedef struct{
+	irobotWorldHeader_t	header;							///< header; offsets are filled in when written
+	irobotWorldRamp_t	ramps[IROBOT_WORLD_RAMPS];		///< ramps
+	uint8_t *			cells;							///< cells, row by row from -y
+	uint64_t			randomState;					///< generator state
+} worldBuilder_t;
+
+static uint64_t clockNs(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/// xorshift64; deterministic so that worlds are reproducible
+static uint32_t randomNext(worldBuilder_t * const pBuilder){
+	pBuilder->randomState ^= pBuilder->randomState << 13;
+	pBuilder->randomState ^= pBuilder->randomState >> 7;
+	pBuilder->randomState ^= pBuilder->randomState << 17;
+	return (uint32_t)(pBuilder->randomState >> 32);
+}
+
+/// \returns uniform double in [low, high)
+static double randomRange(worldBuilder_t * const pBuilder, const double low, const double high){
+	return low + (high - low) * (randomNext(pBuilder) / 4294967296.0);
+}
+
+//*****************************************************
+// drawing                                            *
+//*****************************************************
+
+/// Set the cells of a rectangle, in mm.
+static void worldFillRect(worldBuilder_t * const pBuilder, const double x0, const double y0, const double x1, const double y1, const uint8_t value){
+	const irobotWorldHeader_t * const	pHeader = &pBuilder->header;
+	const double						half = pHeader->roomSize / 2;
+	const int32_t						n = (int32_t)pHeader->cellsPerSide;
+	int32_t								c0 = (int32_t)floor((fmin(x0, x1) + half) / pHeader->cellSize);
+	int32_t								c1 = (int32_t)ceil((fmax(x0, x1) + half) / pHeader->cellSize);
+	int32_t								r0 = (int32_t)floor((fmin(y0, y1) + half) / pHeader->cellSize);
+	int32_t								r1 = (int32_t)ceil((fmax(y0, y1) + half) / pHeader->cellSize);
+	int32_t								r;
+
+	c0 = c0 < 0 ? 0 : c0;
+	r0 = r0 < 0 ? 0 : r0;
+	c1 = c1 > n ? n : c1;
+	r1 = r1 > n ? n : r1;
+	for(r = r0; r < r1; r++){
+		if(c1 > c0){
+			memset(&pBuilder->cells[(size_t)r * n + c0], value, (size_t)(c1 - c0));
+		}
+	}
+}
+
+/// Set the cells of a random rectangle within the room.
+static void worldRandomRect(worldBuilder_t * const pBuilder, const double minSide, const double maxSide, const uint8_t value){
+	const double half = pBuilder->header.roomSize / 2;
+	const double width = randomRange(pBuilder, minSide, maxSide);
+	const double height = randomRange(pBuilder, minSide, maxSide);
+	const double x = randomRange(pBuilder, -half, half - width);
+	const double y = randomRange(pBuilder, -half, half - height);
+
+	worldFillRect(pBuilder, x, y, x + width, y + height, value);
+}
+
+/// Clear the cells around the start.
+static void worldClearStart(worldBuilder_t * const pBuilder){
+	const double x = pBuilder->header.startX;
+	const double y = pBuilder->header.startY;
+
+	worldFillRect(pBuilder, x - startClearance, y - startClearance, x + startClearance, y + startClearance, IROBOT_WORLD_FLOOR);
+}
+
+//*****************************************************
+// kinds                                              *
+//*****************************************************
+
+static void worldRoom(worldBuilder_t * const pBuilder){
+	const uint32_t	nBoxes = 2 + randomNext(pBuilder) % 7;
+	uint32_t		i;
+
+	for(i = 0; i < nBoxes; i++){
+		worldRandomRect(pBuilder, 200, 800, IROBOT_WORLD_WALL);
+	}
+	worldClearStart(pBuilder);
+}
+
+/// Carve a maze with an iterative depth-first search.
+static void worldMaze(worldBuilder_t * const pBuilder){
+	const double	half = pBuilder->header.roomSize / 2;
+	const uint32_t	side = (uint32_t)(pBuilder->header.roomSize / corridorWidth) > 0 ? (uint32_t)(pBuilder->header.roomSize / corridorWidth) : 1;
+	const double	pitch = pBuilder->header.roomSize / side;
+	bool *			visited = calloc((size_t)side * side, sizeof(bool));
+	uint32_t *		stack = malloc((size_t)side * side * sizeof(uint32_t));
+	uint32_t		nStack = 0;
+	uint32_t		i;
+
+	if(!visited || !stack){
+		fprintf(stderr, "worldgen: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// every maze cell is a room; walls are knocked out between rooms as they are visited
+	worldFillRect(pBuilder, -half, -half, half, half, IROBOT_WORLD_WALL);
+	for(i = 0; i < side * side; i++){
+		const double x = -half + (i % side) * pitch;
+		const double y = -half + (i / side) * pitch;
+
+		worldFillRect(pBuilder, x + mazeWallWidth / 2, y + mazeWallWidth / 2, x + pitch - mazeWallWidth / 2, y + pitch - mazeWallWidth / 2, IROBOT_WORLD_FLOOR);
+	}
+
+	visited[0] = true;
+	stack[nStack++] = 0;
+	while(nStack > 0){
+		const uint32_t	current = stack[nStack - 1];
+		const uint32_t	column = current % side;
+		const uint32_t	row = current / side;
+		uint32_t		neighbors[4];
+		uint32_t		nNeighbors = 0;
+
+		if(column > 0 && !visited[current - 1]){
+			neighbors[nNeighbors++] = current - 1;
+		}
+		if(column + 1 < side && !visited[current + 1]){
+			neighbors[nNeighbors++] = current + 1;
+		}
+		if(row > 0 && !visited[current - side]){
+			neighbors[nNeighbors++] = current - side;
+		}
+		if(row + 1 < side && !visited[current + side]){
+			neighbors[nNeighbors++] = current + side;
+		}
+
+		if(nNeighbors == 0){
+			nStack--;
+		}
+		else{
+			const uint32_t	next = neighbors[randomNext(pBuilder) % nNeighbors];
+			const double	x0 = -half + (current % side + 0.5) * pitch;
+			const double	y0 = -half + (current / side + 0.5) * pitch;
+			const double	x1 = -half + (next % side + 0.5) * pitch;
+			const double	y1 = -half + (next / side + 0.5) * pitch;
+			const double	opening = (pitch - mazeWallWidth) / 2;
+
+			// open the wall between the two rooms
+			worldFillRect(pBuilder, fmin(x0, x1) - opening, fmin(y0, y1) - opening, fmax(x0, x1) + opening, fmax(y0, y1) + opening, IROBOT_WORLD_FLOOR);
+			visited[next] = true;
+			stack[nStack++] = next;
+		}
+	}
+
+	pBuilder->header.startX = (float)(-half + pitch / 2);
+	pBuilder->header.startY = (float)(-half + pitch / 2);
+	free(visited);
+	free(stack);
+}
+
+static void worldCliffs(worldBuilder_t * const pBuilder){
+	const uint32_t	nPits = 2 + randomNext(pBuilder) % 5;
+	uint32_t		i;
+
+	for(i = 0; i < nPits; i++){
+		worldRandomRect(pBuilder, 200, 700, IROBOT_WORLD_CLIFF);
+	}
+	worldClearStart(pBuilder);
+}
+
+static void worldRamps(worldBuilder_t * const pBuilder){
+	const uint32_t	nRamps = 2 + randomNext(pBuilder) % 5;
+	uint32_t		i;
+
+	for(i = 0; i < nRamps; i++){
+		pBuilder->ramps[i].inclination = (float)randomRange(pBuilder, minInclination, maxInclination);
+		pBuilder->ramps[i].uphill = (float)randomRange(pBuilder, -M_PI, M_PI);
+		worldRandomRect(pBuilder, 600, 1500, (uint8_t)(IROBOT_WORLD_RAMP + i));
+	}
+	pBuilder->header.nRamps = nRamps;
+	worldClearStart(pBuilder);
+}
+
+//*****************************************************
+// pack                                               *
+//*****************************************************
+
+/// Generate one world into the builder.
+static void worldGenerate(worldBuilder_t * const pBuilder, const uint32_t kind, const uint32_t seed, const double roomSize, const double cellSize){
+	irobotWorldHeader_t * const pHeader = &pBuilder->header;
+
+	memset(pHeader, 0, sizeof(*pHeader));
+	pHeader->kind = kind;
+	pHeader->seed = seed;
+	pHeader->roomSize = (float)roomSize;
+	pHeader->cellSize = (float)cellSize;
+	pHeader->cellsPerSide = (uint32_t)ceil(roomSize / cellSize);
+	memset(pBuilder->cells, IROBOT_WORLD_FLOOR, (size_t)pHeader->cellsPerSide * pHeader->cellsPerSide);
+
+	// a zero state would stay zero
+	pBuilder->randomState = 0x9E3779B97F4A7C15ULL * (seed + 1);
+	pHeader->startHeading = (float)randomRange(pBuilder, -M_PI, M_PI);
+
+	switch(kind){
+	case IROBOT_WORLD_KIND_ROOM:	worldRoom(pBuilder);	break;
+	case IROBOT_WORLD_KIND_MAZE:	worldMaze(pBuilder);	break;
+	case IROBOT_WORLD_KIND_CLIFFS:	worldCliffs(pBuilder);	break;
+	case IROBOT_WORLD_KIND_RAMPS:	worldRamps(pBuilder);	break;
+	default:						break;
+	}
+}
+
+/// Write the builder's world at the end of the pack, aligned.
+/// \returns false on a write error
+static bool worldWrite(FILE * const file, worldBuilder_t * const pBuilder, irobotWorldPackEntry_t * const pEntry){
+	static const uint8_t	padding[IROBOT_WORLD_ALIGNMENT];
+	irobotWorldHeader_t *	pHeader = &pBuilder->header;
+	const size_t			nCells = (size_t)pHeader->cellsPerSide * pHeader->cellsPerSide;
+	long					offset;
+
+	if(fseek(file, 0, SEEK_END) != 0 || (offset = ftell(file)) < 0){
+		return false;
+	}
+	if(offset % IROBOT_WORLD_ALIGNMENT != 0){
+		const size_t nPadding = IROBOT_WORLD_ALIGNMENT - offset % IROBOT_WORLD_ALIGNMENT;
+
+		if(fwrite(padding, 1, nPadding, file) != nPadding){
+			return false;
+		}
+		offset += (long)nPadding;
+	}
+
+	pHeader->rampsOffset = sizeof(*pHeader);
+	pHeader->cellsOffset = pHeader->rampsOffset + pHeader->nRamps * sizeof(irobotWorldRamp_t);
+	pEntry->offset = (uint64_t)offset;
+	pEntry->size = pHeader->cellsOffset + nCells;
+
+	return fwrite(pHeader, sizeof(*pHeader), 1, file) == 1
+		&& fwrite(pBuilder->ramps, sizeof(irobotWorldRamp_t), pHeader->nRamps, file) == pHeader->nRamps
+		&& fwrite(pBuilder->cells, 1, nCells, file) == nCells;
+}
+
+/// Generate a pack.
+/// \returns false on an error
+static bool packGenerate(const char * const path, const uint32_t nWorlds, const uint32_t seed, const int32_t kind, const double roomSize, const double cellSize){
+	irobotWorldPackHeader_t		header;
+	irobotWorldPackEntry_t *	table = calloc(nWorlds ? nWorlds : 1, sizeof(*table));
+	static worldBuilder_t		builder;
+	const uint32_t				cellsPerSide = (uint32_t)ceil(roomSize / cellSize);
+	FILE *						file = fopen(path, "wb");
+	bool						ok;
+	uint64_t					ns = clockNs();
+	uint32_t					i;
+
+	builder.cells = malloc((size_t)cellsPerSide * cellsPerSide);
+	if(!file || !table || !builder.cells){
+		perror("worldgen");
+		return false;
+	}
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, IROBOT_WORLD_MAGIC, sizeof(header.magic));
+	header.version = IROBOT_WORLD_VERSION;
+	header.byteOrder = IROBOT_WORLD_BYTE_ORDER;
+	header.nWorlds = nWorlds;
+	header.tableOffset = sizeof(header);
+
+	// reserve the header and table; they are rewritten once the offsets are known
+	ok = fwrite(&header, sizeof(header), 1, file) == 1
+		&& fwrite(table, sizeof(*table), nWorlds, file) == nWorlds;
+	for(i = 0; ok && i < nWorlds; i++){
+		worldGenerate(&builder, kind >= 0 ? (uint32_t)kind : i % IROBOT_WORLD_KINDS, seed + i, roomSize, cellSize);
+		ok = worldWrite(file, &builder, &table[i]);
+	}
+	ok = ok
+		&& fseek(file, 0, SEEK_SET) == 0
+		&& fwrite(&header, sizeof(header), 1, file) == 1
+		&& fwrite(table, sizeof(*table), nWorlds, file) == nWorlds;
+	ok = fclose(file) == 0 && ok;
+	if(!ok){
+		perror("worldgen: write");
+	}
+	else{
+		printf("%u worlds of %u x %u cells in %.3f s\n", nWorlds, cellsPerSide, cellsPerSide, (clockNs() - ns) / 1e9);
+	}
+
+	free(builder.cells);
+	free(table);
+	return ok;
+}
+
+/// Write a world as a PGM image: floor white, walls black, cliffs dark, ramps shaded by inclination.
+static bool worldWriteImage(const irobotWorld_t * const pWorld, const char * const path){
+	const uint32_t	n = pWorld->pHeader->cellsPerSide;
+	FILE * const	file = fopen(path, "wb");
+	uint32_t		row;
+	uint32_t		column;
+
+	if(!file){
+		perror("worldgen: fopen");
+		return false;
+	}
+	fprintf(file, "P5\n%u %u\n255\n", n, n);
+	for(row = n; row-- > 0;){
+		for(column = 0; column < n; column++){
+			const uint8_t	cell = pWorld->cells[(size_t)row * n + column];
+			uint8_t			shade = 255;
+
+			if(cell == IROBOT_WORLD_WALL){
+				shade = 0;
+			}
+			else if(cell == IROBOT_WORLD_CLIFF){
+				shade = 64;
+			}
+			else if(cell >= IROBOT_WORLD_RAMP && (uint32_t)(cell - IROBOT_WORLD_RAMP) < pWorld->pHeader->nRamps){
+				shade = (uint8_t)(240 - 10 * pWorld->ramps[cell - IROBOT_WORLD_RAMP].inclination);
+			}
+			fputc(shade, file);
+		}
+	}
+	return fclose(file) == 0;
+}
+
+/// Map a pack, fetch every world, and print what it holds.
+/// \returns false on an error
+static bool packInspect(const char * const path, const int64_t imageWorld, const char * const imagePath){
+	irobotWorldPack_t	pack;
+	irobotWorld_t		world;
+	uint32_t			kinds[IROBOT_WORLD_KINDS + 1] = {0};
+	uint64_t			nsOpen;
+	uint64_t			nsGet;
+	uint32_t			sum = 0;
+	uint32_t			i;
+
+	nsOpen = clockNs();
+	if(!irobotWorldPackOpen(&pack, path)){
+		return false;
+	}
+	nsOpen = clockNs() - nsOpen;
+
+	// a worker fetches a world and reads its start cell
+	nsGet = clockNs();
+	for(i = 0; i < pack.nWorlds; i++){
+		if(!irobotWorldPackGet(&pack, i, &world)){
+			fprintf(stderr, "worldgen: world %u is corrupt\n", i);
+			irobotWorldPackClose(&pack);
+			return false;
+		}
+		sum += irobotWorldCell(&world, world.pHeader->startX, world.pHeader->startY);
+	}
+	nsGet = clockNs() - nsGet;
+
+	for(i = 0; i < pack.nWorlds; i++){
+		irobotWorldPackGet(&pack, i, &world);
+		kinds[world.pHeader->kind < IROBOT_WORLD_KINDS ? world.pHeader->kind : IROBOT_WORLD_KINDS]++;
+	}
+
+	printf("%u worlds, %zu bytes, version %u\n", pack.nWorlds, pack.size, IROBOT_WORLD_VERSION);
+	for(i = 0; i <= IROBOT_WORLD_KINDS; i++){
+		if(kinds[i] > 0){
+			printf("  %-8s %u\n", irobotWorldKindName(i), kinds[i]);
+		}
+	}
+	printf("open %.1f us, fetch %.3f us per world%s\n",
+			nsOpen / 1e3,
+			pack.nWorlds ? nsGet / 1e3 / pack.nWorlds : 0,
+			sum ? " (a start cell is not floor)" : "");
+
+	if(imageWorld >= 0 && imagePath){
+		if(!irobotWorldPackGet(&pack, (uint32_t)imageWorld, &world) || !worldWriteImage(&world, imagePath)){
+			fprintf(stderr, "worldgen: could not write world %lld\n", (long long)imageWorld);
+			irobotWorldPackClose(&pack);
+			return false;
+		}
+		printf("world %lld (%s, seed %u) written to %s\n",
+				(long long)imageWorld, irobotWorldKindName(world.pHeader->kind), world.pHeader->seed, imagePath);
+	}
+
+	irobotWorldPackClose(&pack);
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t		nWorlds = defaultWorlds;
+	uint32_t		seed = defaultSeed;
+	double			roomSize = defaultRoomSize;
+	double			cellSize = defaultCellSize;
+	int32_t			kind = -1;
+	bool			inspect = false;
+	int64_t			imageWorld = -1;
+	const char *	imagePath = NULL;
+	int				option;
+
+	while((option = getopt(argc, argv, "n:s:r:c:k:ix:o:")) != -1){
+		switch(option){
+		case 'n': nWorlds = (uint32_t)strtoul(optarg, NULL, 10); break;
+		case 's': seed = (uint32_t)strtoul(optarg, NULL, 10); break;
+		case 'r': roomSize = atof(optarg); break;
+		case 'c': cellSize = atof(optarg); break;
+		case 'k':
+			for(kind = 0; kind < IROBOT_WORLD_KINDS && strcmp(optarg, irobotWorldKindName((uint32_t)kind)) != 0; kind++){
+			}
+			if(kind == IROBOT_WORLD_KINDS){
+				fprintf(stderr, "worldgen: kinds are room, maze, cliffs and ramps\n");
+				return EXIT_FAILURE;
+			}
+			break;
+		case 'i': inspect = true; break;
+		case 'x': imageWorld = strtoll(optarg, NULL, 10); break;
+		case 'o': imagePath = optarg; break;
+		default:
+			optind = argc;
+			break;
+		}
+	}
+	if(optind != argc - 1 || !(roomSize > 0) || !(cellSize > 0)){
+		fprintf(stderr, "Usage: %s [-n worlds] [-s seed] [-r room size, in mm] [-c cell size, in mm] [-k kind] <pack file>\n", argv[0]);
+		fprintf(stderr, "       %s -i [-x world -o image.pgm] <pack file>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if(inspect){
+		return packInspect(argv[optind], imageWorld, imagePath) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	return packGenerate(argv[optind], nWorlds, seed, kind, roomSize, cellSize) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
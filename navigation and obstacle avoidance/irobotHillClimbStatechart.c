@@ -8,8 +8,11 @@
  */
 
 #include "irobotNavigationStatechart.h"
+#include "irobotHillClimb.h"
+#include "irobotStatechartCoverage.h"
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 // Program States
 typedef enum{
@@ -23,9 +26,6 @@ typedef enum{
 	REORIENT							// Reorient after obstacle avoidance
 } robotState_t;
 
-#define DEG_PER_RAD			(180.0 / M_PI)		// degrees per radian
-#define RAD_PER_DEG			(M_PI / 180.0)		// radians per degree
-
 // state data
 static const double  hillThreshold = 10;		// inclinations above this value are considered a hill, in deg
 static const double  levelThreshold = 7;		// inclinations below this value are considered level ground, in deg
@@ -40,7 +40,40 @@ typedef enum{
 	RIGHT
 } obstacleDirection_t;							// Direction of an encountered obstacle
 
-void irobotNavigationStatechart(
+// statechart state; exported through the context functions
+static robotState_t 		state = INITIAL;				// current program state
+static robotState_t			unpausedState = DRIVE;			// state history for pause region
+static obstacleDirection_t	obstacleDirection = LEFT;		// direction of an obstacle to avoid
+static int32_t				distanceAtManeuverStart = 0;	// distance robot had travelled when a maneuver begins, in mm
+static int32_t				angleAtManeuverStart = 0;		// angle through which the robot had turned when a maneuver begins, in deg
+
+/// Statechart context, as exported to a host that reloads the statechart
+typedef struct{
+	uint32_t				tag;						// identifies this statechart and context layout
+	robotState_t			state;
+	robotState_t			unpausedState;
+	obstacleDirection_t		obstacleDirection;
+	int32_t					distanceAtManeuverStart;
+	int32_t					angleAtManeuverStart;
+	double					tiltCorrection;
+} statechartContext_t;
+
+static const uint32_t contextTag = 0x48494C31;	// "HIL1"
+
+// transition coverage, by program state
+static const char * const stateNames[] = {
+	"INITIAL",
+	"PAUSE_WAIT_BUTTON_RELEASE",
+	"UNPAUSE_WAIT_BUTTON_PRESS",
+	"UNPAUSE_WAIT_BUTTON_RELEASE",
+	"DRIVE",
+	"CLIMB",
+	"AVOID",
+	"REORIENT"
+};
+STATECHART_COVERAGE_DEFINE("irobotHillClimbStatechart", stateNames);
+
+uint32_t IROBOT_STATECHART_SYMBOL(irobotHillClimbStatechart, )(
 	const int32_t 				netDistance,
 	const int32_t 				netAngle,
 	const irobotSensorGroup6_t	sensors,
@@ -49,13 +82,6 @@ void irobotNavigationStatechart(
 	int16_t * const 			pRightWheelSpeed,
 	int16_t * const 			pLeftWheelSpeed
 ){
-	// local state
-	static robotState_t 		state = INITIAL;				// current program state
-	static robotState_t			unpausedState = DRIVE;			// state history for pause region
-	static obstacleDirection_t	obstacleDirection = LEFT;		// direction of an obstacle to avoid
-	static int32_t				distanceAtManeuverStart = 0;	// distance robot had travelled when a maneuver begins, in mm
-	static int32_t				angleAtManeuverStart = 0;		// angle through which the robot had turned when a maneuver begins, in deg
-
 	// local data
 	double						inclination = 0;				// inclination of the robot, in deg
 	double						tilt = 0;						// tilt of the robot, in deg
@@ -63,12 +89,15 @@ void irobotNavigationStatechart(
 	// outputs
 	int16_t						leftWheelSpeed = 0;				// speed of the left wheel, in mm/s
 	int16_t						rightWheelSpeed = 0;			// speed of the right wheel, in mm/s
+	uint32_t					periodMs = STATECHART_PERIOD_DRIVE_MS;	// period until the next execution, in ms
+
+	STATECHART_COVERAGE_FROM(state);
 
 	/******************************************************/
 	// state data - process inputs                       
 	/******************************************************/
-	inclination = sqrt(accelAxes.x*accelAxes.x + accelAxes.y*accelAxes.y) * 90.0;
-	tilt = atan2(accelAxes.y, accelAxes.x) * DEG_PER_RAD + tiltCorrection;
+	inclination = hillClimbInclination(accelAxes);
+	tilt = hillClimbTilt(accelAxes, tiltCorrection);
 
 	/******************************************************/
 	// state transition - pause region (highest priority)
@@ -168,6 +197,8 @@ void irobotNavigationStatechart(
 	}
 	// else, no transitions are taken
 
+	STATECHART_COVERAGE_TO(state);
+
 	/////////////////////////////////////////
 	//             state actions           //
 	/////////////////////////////////////////
@@ -178,6 +209,7 @@ void irobotNavigationStatechart(
 	case UNPAUSE_WAIT_BUTTON_RELEASE:
 		// in pause mode, robot should be stopped
 		leftWheelSpeed = rightWheelSpeed = 0;
+		periodMs = STATECHART_PERIOD_PAUSE_MS;
 		break;
 
 	case AVOID:
@@ -190,6 +222,7 @@ void irobotNavigationStatechart(
 			leftWheelSpeed = -(driveSpeed >> 4);
 			rightWheelSpeed = -driveSpeed;
 		}
+		periodMs = STATECHART_PERIOD_MANEUVER_MS;
 		break;
 
 	case REORIENT:
@@ -202,6 +235,7 @@ void irobotNavigationStatechart(
 			leftWheelSpeed = reorientSpeed;
 			rightWheelSpeed = -reorientSpeed;
 		}
+		periodMs = STATECHART_PERIOD_MANEUVER_MS;
 		break;
 
 	case DRIVE:
@@ -211,8 +245,7 @@ void irobotNavigationStatechart(
 
 	case CLIMB:
 		// proportional controller
-		leftWheelSpeed = (int32_t)((double)driveSpeed * cos((45 + tilt) * RAD_PER_DEG));
-		rightWheelSpeed = (int32_t)((double)driveSpeed * sin((45 + tilt) * RAD_PER_DEG));
+		hillClimbWheelSpeeds(driveSpeed, tilt, &rightWheelSpeed, &leftWheelSpeed);
 		break;
 
 	default:
@@ -224,4 +257,65 @@ void irobotNavigationStatechart(
 	// write outputs
 	*pLeftWheelSpeed = leftWheelSpeed;
 	*pRightWheelSpeed = rightWheelSpeed;
+
+	return periodMs;
+}
+
+size_t IROBOT_STATECHART_SYMBOL(irobotHillClimbStatechart, ContextSave)(void * const pContext, const size_t contextSize){
+	statechartContext_t context;
+
+	if(!pContext || contextSize < sizeof(context)){
+		return 0;
+	}
+
+	context.tag = contextTag;
+	context.state = state;
+	context.unpausedState = unpausedState;
+	context.obstacleDirection = obstacleDirection;
+	context.distanceAtManeuverStart = distanceAtManeuverStart;
+	context.angleAtManeuverStart = angleAtManeuverStart;
+	context.tiltCorrection = tiltCorrection;
+	memcpy(pContext, &context, sizeof(context));
+
+	return sizeof(context);
+}
+
+bool IROBOT_STATECHART_SYMBOL(irobotHillClimbStatechart, ContextRestore)(const void * const pContext, const size_t contextSize){
+	statechartContext_t context;
+
+	if(!pContext || contextSize != sizeof(context)){
+		return false;
+	}
+
+	memcpy(&context, pContext, sizeof(context));
+	if(context.tag != contextTag){
+		return false;
+	}
+
+	state = context.state;
+	unpausedState = context.unpausedState;
+	obstacleDirection = context.obstacleDirection;
+	distanceAtManeuverStart = context.distanceAtManeuverStart;
+	angleAtManeuverStart = context.angleAtManeuverStart;
+	tiltCorrection = context.tiltCorrection;
+
+	return true;
+}
+
+bool IROBOT_STATECHART_SYMBOL(irobotHillClimbStatechart, Maneuver)(irobotManeuver_t * const pManeuver){
+	switch(state){
+	case AVOID:
+		// backing up until the avoid distance
+		pManeuver->end = MANEUVER_DISTANCE;
+		pManeuver->target = distanceAtManeuverStart - avoidDistance;
+		return true;
+	case REORIENT:
+		// turning back to the orientation at the first obstacle
+		pManeuver->end = MANEUVER_ANGLE;
+		pManeuver->target = angleAtManeuverStart;
+		return true;
+	default:
+		pManeuver->end = MANEUVER_NONE;
+		return false;
+	}
 }
@@ -9,8 +9,10 @@
 
 
 #include "irobotNavigationStatechart.h"
+#include "irobotStatechartCoverage.h"
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 // Program States
 typedef enum{
@@ -37,7 +39,38 @@ typedef enum{
 	RIGHT
 } obstacleDirection_t;							// Direction of an encountered obstacle
 
-void irobotNavigationStatechart(
+// statechart state; exported through the context functions
+static robotState_t 		state = INITIAL;				// current program state
+static robotState_t			unpausedState = DRIVE;			// state history for pause region
+static obstacleDirection_t	obstacleDirection = LEFT;		// direction of an obstacle to avoid
+static int32_t				distanceAtManeuverStart = 0;	// distance robot had travelled when a maneuver begins, in mm
+static int32_t				angleAtManeuverStart = 0;		// angle through which the robot had turned when a maneuver begins, in deg
+
+/// Statechart context, as exported to a host that reloads the statechart
+typedef struct{
+	uint32_t				tag;						// identifies this statechart and context layout
+	robotState_t			state;
+	robotState_t			unpausedState;
+	obstacleDirection_t		obstacleDirection;
+	int32_t					distanceAtManeuverStart;
+	int32_t					angleAtManeuverStart;
+} statechartContext_t;
+
+static const uint32_t contextTag = 0x4E415631;	// "NAV1"
+
+// transition coverage, by program state
+static const char * const stateNames[] = {
+	"INITIAL",
+	"PAUSE_WAIT_BUTTON_RELEASE",
+	"UNPAUSE_WAIT_BUTTON_PRESS",
+	"UNPAUSE_WAIT_BUTTON_RELEASE",
+	"DRIVE",
+	"AVOID",
+	"REORIENT"
+};
+STATECHART_COVERAGE_DEFINE("irobotNavStatechart", stateNames);
+
+uint32_t IROBOT_STATECHART_SYMBOL(irobotNavStatechart, )(
 	const int32_t 				netDistance,
 	const int32_t 				netAngle,
 	const irobotSensorGroup6_t	sensors,
@@ -46,16 +79,12 @@ void irobotNavigationStatechart(
 	int16_t * const 			pRightWheelSpeed,
 	int16_t * const 			pLeftWheelSpeed
 ){
-	// local state
-	static robotState_t 		state = INITIAL;				// current program state
-	static robotState_t			unpausedState = DRIVE;			// state history for pause region
-	static obstacleDirection_t	obstacleDirection = LEFT;		// direction of an obstacle to avoid
-	static int32_t				distanceAtManeuverStart = 0;	// distance robot had travelled when a maneuver begins, in mm
-	static int32_t				angleAtManeuverStart = 0;		// angle through which the robot had turned when a maneuver begins, in deg
-
 	// outputs
 	int16_t						leftWheelSpeed = 0;				// speed of the left wheel, in mm/s
 	int16_t						rightWheelSpeed = 0;			// speed of the right wheel, in mm/s
+	uint32_t					periodMs = STATECHART_PERIOD_DRIVE_MS;	// period until the next execution, in ms
+
+	STATECHART_COVERAGE_FROM(state);
 
 	/******************************************************/
 	// state data - process inputs                       
@@ -146,6 +175,8 @@ void irobotNavigationStatechart(
 	}
 	// else, no transitions are taken
 
+	STATECHART_COVERAGE_TO(state);
+
 	/////////////////////////////////////////
 	//             state actions           //
 	/////////////////////////////////////////
@@ -156,6 +187,7 @@ void irobotNavigationStatechart(
 	case UNPAUSE_WAIT_BUTTON_RELEASE:
 		// in pause mode, robot should be stopped
 		leftWheelSpeed = rightWheelSpeed = 0;
+		periodMs = STATECHART_PERIOD_PAUSE_MS;
 		break;
 
 	case AVOID:
@@ -168,6 +200,7 @@ void irobotNavigationStatechart(
 			leftWheelSpeed = -(driveSpeed >> 4);
 			rightWheelSpeed = -driveSpeed;
 		}
+		periodMs = STATECHART_PERIOD_MANEUVER_MS;
 		break;
 
 	case REORIENT:
@@ -180,6 +213,7 @@ void irobotNavigationStatechart(
 			leftWheelSpeed = reorientSpeed;
 			rightWheelSpeed = -reorientSpeed;
 		}
+		periodMs = STATECHART_PERIOD_MANEUVER_MS;
 		break;
 
 	case DRIVE:
@@ -196,4 +230,63 @@ void irobotNavigationStatechart(
 	// write outputs
 	*pLeftWheelSpeed = leftWheelSpeed;
 	*pRightWheelSpeed = rightWheelSpeed;
+
+	return periodMs;
+}
+
+size_t IROBOT_STATECHART_SYMBOL(irobotNavStatechart, ContextSave)(void * const pContext, const size_t contextSize){
+	statechartContext_t context;
+
+	if(!pContext || contextSize < sizeof(context)){
+		return 0;
+	}
+
+	context.tag = contextTag;
+	context.state = state;
+	context.unpausedState = unpausedState;
+	context.obstacleDirection = obstacleDirection;
+	context.distanceAtManeuverStart = distanceAtManeuverStart;
+	context.angleAtManeuverStart = angleAtManeuverStart;
+	memcpy(pContext, &context, sizeof(context));
+
+	return sizeof(context);
+}
+
+bool IROBOT_STATECHART_SYMBOL(irobotNavStatechart, ContextRestore)(const void * const pContext, const size_t contextSize){
+	statechartContext_t context;
+
+	if(!pContext || contextSize != sizeof(context)){
+		return false;
+	}
+
+	memcpy(&context, pContext, sizeof(context));
+	if(context.tag != contextTag){
+		return false;
+	}
+
+	state = context.state;
+	unpausedState = context.unpausedState;
+	obstacleDirection = context.obstacleDirection;
+	distanceAtManeuverStart = context.distanceAtManeuverStart;
+	angleAtManeuverStart = context.angleAtManeuverStart;
+
+	return true;
+}
+
+bool IROBOT_STATECHART_SYMBOL(irobotNavStatechart, Maneuver)(irobotManeuver_t * const pManeuver){
+	switch(state){
+	case AVOID:
+		// backing up until the avoid distance
+		pManeuver->end = MANEUVER_DISTANCE;
+		pManeuver->target = distanceAtManeuverStart - avoidDistance;
+		return true;
+	case REORIENT:
+		// turning back to the orientation at the first obstacle
+		pManeuver->end = MANEUVER_ANGLE;
+		pManeuver->target = angleAtManeuverStart;
+		return true;
+	default:
+		pManeuver->end = MANEUVER_NONE;
+		return false;
+	}
 }
@@ -0,0 +1,174 @@
+/*
+ *	irobotNavStatechartTable.h
+ *
+ *	Lookup-table form of irobotNavStatechart.c.
+ *
+ *	The transitions of irobotNavStatechart.c depend only on a small discrete
+ *	input: the play button, an obstacle on the left or right, and three
+ *	comparisons of the net distance and angle against the maneuver start.
+ *	Its discrete state is the program state, the state history of the pause
+ *	region and the obstacle direction. The tablegen target enumerates every
+ *	(state, input) pair against the original statechart and writes
+ *	irobotNavStatechartTableData.h; a step is then one table load.
+ *
+ *	The state numbering, context layout and thresholds below mirror
+ *	irobotNavStatechart.c; tablegen --verify checks the table against it
+ *	tick for tick, and must be rerun whenever that statechart changes.
+ *
+ */
+
+#ifndef IROBOTNAVSTATECHARTTABLE_H_
+#define IROBOTNAVSTATECHARTTABLE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "irobotSensorTypes.h"
+
+// program states of irobotNavStatechart.c
+#define NAVTABLE_PROGRAM_STATES		7		// INITIAL .. REORIENT
+#define NAVTABLE_DRIVE				4		// DRIVE; first state of the run region
+#define NAVTABLE_AVOID				5		// AVOID
+#define NAVTABLE_REORIENT			6		// REORIENT
+#define NAVTABLE_RUN_STATES			3		// DRIVE, AVOID, REORIENT; the only states the pause region returns to
+#define NAVTABLE_DIRECTIONS			2		// LEFT, RIGHT
+
+// thresholds of irobotNavStatechart.c
+#define NAVTABLE_AVOID_DISTANCE		250		// distance to travel in avoidance before reorienting, in mm
+#define NAVTABLE_REORIENT_TOLERANCE	2		// tolerance for reorienting, in deg
+
+/// Dense index of (program state, unpaused state, obstacle direction)
+#define NAVTABLE_STATES				(NAVTABLE_PROGRAM_STATES * NAVTABLE_RUN_STATES * NAVTABLE_DIRECTIONS)
+
+// input bits
+#define NAVTABLE_INPUT_PLAY				0x01	// play button pressed
+#define NAVTABLE_INPUT_OBSTACLE_LEFT	0x02	// bump, wheel drop or cliff on the left
+#define NAVTABLE_INPUT_OBSTACLE_RIGHT	0x04	// bump, wheel drop or cliff on the right
+#define NAVTABLE_INPUT_AVOID_DONE		0x08	// travelled the avoid distance since the maneuver start
+#define NAVTABLE_INPUT_REORIENTED		0x10	// within tolerance of the angle at the maneuver start
+#define NAVTABLE_INPUT_TURN_LEFT		0x20	// shortest reorientation is counter-clockwise
+#define NAVTABLE_INPUTS					0x40
+
+// action bits; the low bits index the output table
+#define NAVTABLE_ACTION_OUTPUT			0x0F	// index into the output table
+#define NAVTABLE_ACTION_LATCH_DISTANCE	0x10	// record the net distance as the maneuver start
+#define NAVTABLE_ACTION_LATCH_ANGLE		0x20	// record the net angle as the maneuver start
+#define NAVTABLE_OUTPUTS				(NAVTABLE_ACTION_OUTPUT + 1)
+
+/// Table entry
+typedef struct{
+	uint8_t		next;					// index of the next state
+	uint8_t		action;					// output index and latches
+} navTableEntry_t;
+
+/// Statechart outputs
+typedef struct{
+	int16_t		leftWheelSpeed;			// speed of the left wheel, in mm/s
+	int16_t		rightWheelSpeed;		// speed of the right wheel, in mm/s
+	uint32_t	periodMs;				// period until the next execution, in ms
+} navTableOutput_t;
+
+/// Table statechart state
+typedef struct{
+	uint32_t	index;					// index of the discrete state
+	int32_t		distanceAtManeuverStart;	// distance robot had travelled when a maneuver begins, in mm
+	int32_t		angleAtManeuverStart;		// angle through which the robot had turned when a maneuver begins, in deg
+} navTableState_t;
+
+/// Context of irobotNavStatechart.c; shared so that the two statecharts can
+/// be hot-swapped for each other
+typedef struct{
+	uint32_t	tag;					// identifies this statechart and context layout
+	uint32_t	state;
+	uint32_t	unpausedState;
+	uint32_t	obstacleDirection;
+	int32_t		distanceAtManeuverStart;
+	int32_t		angleAtManeuverStart;
+} navTableContext_t;
+
+#define NAVTABLE_CONTEXT_TAG		0x4E415631	// "NAV1"
+
+/// \returns dense index of a discrete state, or NAVTABLE_STATES if the
+/// statechart cannot reach it
+static inline uint32_t navTableStateIndex(
+	const uint32_t state,
+	const uint32_t unpausedState,
+	const uint32_t obstacleDirection
+){
+	if(	  state >= NAVTABLE_PROGRAM_STATES
+	   || unpausedState < NAVTABLE_DRIVE
+	   || unpausedState >= NAVTABLE_DRIVE + NAVTABLE_RUN_STATES
+	   || obstacleDirection >= NAVTABLE_DIRECTIONS
+	){
+		return NAVTABLE_STATES;
+	}
+	return (state * NAVTABLE_RUN_STATES + unpausedState - NAVTABLE_DRIVE) * NAVTABLE_DIRECTIONS + obstacleDirection;
+}
+
+/// Inverse of navTableStateIndex().
+static inline void navTableStateFromIndex(
+	const uint32_t index,
+	uint32_t * const pState,
+	uint32_t * const pUnpausedState,
+	uint32_t * const pObstacleDirection
+){
+	*pObstacleDirection = index % NAVTABLE_DIRECTIONS;
+	*pUnpausedState = index / NAVTABLE_DIRECTIONS % NAVTABLE_RUN_STATES + NAVTABLE_DRIVE;
+	*pState = index / (NAVTABLE_DIRECTIONS * NAVTABLE_RUN_STATES);
+}
+
+/// Reduce the statechart inputs to an input bitmask, without branching.
+static inline uint32_t navTableInputs(
+	const navTableState_t * const	pState,
+	const int32_t					netDistance,
+	const int32_t					netAngle,
+	const irobotSensorGroup6_t		sensors
+){
+	const bool obstacleLeft =
+		  sensors.bumps_wheelDrops.bumpLeft
+		| sensors.bumps_wheelDrops.wheeldropLeft
+		| sensors.cliffLeft
+		| sensors.cliffFrontLeft;
+	const bool obstacleRight =
+		  sensors.bumps_wheelDrops.bumpRight
+		| sensors.bumps_wheelDrops.wheeldropRight
+		| sensors.cliffFrontRight
+		| sensors.cliffRight;
+	const bool play = sensors.buttons.play;
+	const int32_t angleError = netAngle - pState->angleAtManeuverStart;
+
+	return (uint32_t)play * NAVTABLE_INPUT_PLAY
+		 | (uint32_t)obstacleLeft * NAVTABLE_INPUT_OBSTACLE_LEFT
+		 | (uint32_t)obstacleRight * NAVTABLE_INPUT_OBSTACLE_RIGHT
+		 | (uint32_t)(abs(netDistance - pState->distanceAtManeuverStart) >= NAVTABLE_AVOID_DISTANCE) * NAVTABLE_INPUT_AVOID_DONE
+		 | (uint32_t)(abs(angleError) <= NAVTABLE_REORIENT_TOLERANCE) * NAVTABLE_INPUT_REORIENTED
+		 | (uint32_t)(angleError < 0) * NAVTABLE_INPUT_TURN_LEFT;
+}
+
+/// Execute one step of the table statechart.
+/// \returns period until the next execution, in ms
+static inline uint32_t navTableStep(
+	const navTableEntry_t			table[NAVTABLE_STATES][NAVTABLE_INPUTS],
+	const navTableOutput_t			outputs[NAVTABLE_OUTPUTS],
+	navTableState_t * const			pState,
+	const int32_t					netDistance,
+	const int32_t					netAngle,
+	const irobotSensorGroup6_t		sensors,
+	int16_t * const					pRightWheelSpeed,
+	int16_t * const					pLeftWheelSpeed
+){
+	const navTableEntry_t entry = table[pState->index][navTableInputs(pState, netDistance, netAngle, sensors)];
+	const navTableOutput_t * const pOutput = &outputs[entry.action & NAVTABLE_ACTION_OUTPUT];
+	const int32_t latchDistance = -(int32_t)((entry.action & NAVTABLE_ACTION_LATCH_DISTANCE) != 0);
+	const int32_t latchAngle = -(int32_t)((entry.action & NAVTABLE_ACTION_LATCH_ANGLE) != 0);
+
+	pState->index = entry.next;
+	pState->distanceAtManeuverStart = (netDistance & latchDistance) | (pState->distanceAtManeuverStart & ~latchDistance);
+	pState->angleAtManeuverStart = (netAngle & latchAngle) | (pState->angleAtManeuverStart & ~latchAngle);
+
+	*pLeftWheelSpeed = pOutput->leftWheelSpeed;
+	*pRightWheelSpeed = pOutput->rightWheelSpeed;
+	return pOutput->periodMs;
+}
+
+#endif // IROBOTNAVSTATECHARTTABLE_H_
@@ -0,0 +1,446 @@
+/*
+ *	irobotNavStatechartTableData.h
+ *
+ *	Generated by target/tablegen from irobotNavStatechart.c; do not edit.
+ *	Entries are {next state, action}, indexed by state and input bitmask.
+ *
+ */
+
+#ifndef IROBOTNAVSTATECHARTTABLEDATA_H_
+#define IROBOTNAVSTATECHARTTABLEDATA_H_
+
+#include "irobotNavStatechartTable.h"
+
+static const navTableOutput_t navTableOutputs[NAVTABLE_OUTPUTS] = {
+	{0, 0, 120},
+	{200, 200, 60},
+	{-200, -12, 20},
+	{-12, -200, 20},
+	{75, -75, 20},
+	{-75, 75, 20},
+};
+
+static const navTableEntry_t navTable[NAVTABLE_STATES][NAVTABLE_INPUTS] = {
+	{	// 0: state 0, unpaused 4, direction 0
+		{12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00},
+		{12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00},
+		{12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00},
+		{12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00},
+		{12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00},
+		{12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00},
+		{12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00},
+		{12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00}, {12,0x00},
+	},
+	{	// 1: state 0, unpaused 4, direction 1
+		{13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00},
+		{13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00},
+		{13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00},
+		{13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00},
+		{13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00},
+		{13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00},
+		{13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00},
+		{13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00}, {13,0x00},
+	},
+	{	// 2: state 0, unpaused 5, direction 0
+		{14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00},
+		{14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00},
+		{14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00},
+		{14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00},
+		{14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00},
+		{14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00},
+		{14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00},
+		{14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00}, {14,0x00},
+	},
+	{	// 3: state 0, unpaused 5, direction 1
+		{15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00},
+		{15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00},
+		{15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00},
+		{15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00},
+		{15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00},
+		{15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00},
+		{15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00},
+		{15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00}, {15,0x00},
+	},
+	{	// 4: state 0, unpaused 6, direction 0
+		{16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00},
+		{16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00},
+		{16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00},
+		{16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00},
+		{16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00},
+		{16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00},
+		{16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00},
+		{16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00}, {16,0x00},
+	},
+	{	// 5: state 0, unpaused 6, direction 1
+		{17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00},
+		{17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00},
+		{17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00},
+		{17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00},
+		{17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00},
+		{17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00},
+		{17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00},
+		{17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00}, {17,0x00},
+	},
+	{	// 6: state 1, unpaused 4, direction 0
+		{12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00},
+		{12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00},
+		{12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00},
+		{12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00},
+		{12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00},
+		{12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00},
+		{12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00},
+		{12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00}, {12,0x00}, { 6,0x00},
+	},
+	{	// 7: state 1, unpaused 4, direction 1
+		{13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00},
+		{13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00},
+		{13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00},
+		{13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00},
+		{13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00},
+		{13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00},
+		{13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00},
+		{13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00}, {13,0x00}, { 7,0x00},
+	},
+	{	// 8: state 1, unpaused 5, direction 0
+		{14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00},
+		{14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00},
+		{14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00},
+		{14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00},
+		{14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00},
+		{14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00},
+		{14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00},
+		{14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00}, {14,0x00}, { 8,0x00},
+	},
+	{	// 9: state 1, unpaused 5, direction 1
+		{15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00},
+		{15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00},
+		{15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00},
+		{15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00},
+		{15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00},
+		{15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00},
+		{15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00},
+		{15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00}, {15,0x00}, { 9,0x00},
+	},
+	{	// 10: state 1, unpaused 6, direction 0
+		{16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00},
+		{16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00},
+		{16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00},
+		{16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00},
+		{16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00},
+		{16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00},
+		{16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00},
+		{16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00}, {16,0x00}, {10,0x00},
+	},
+	{	// 11: state 1, unpaused 6, direction 1
+		{17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00},
+		{17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00},
+		{17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00},
+		{17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00},
+		{17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00},
+		{17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00},
+		{17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00},
+		{17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00}, {17,0x00}, {11,0x00},
+	},
+	{	// 12: state 2, unpaused 4, direction 0
+		{12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00},
+		{12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00},
+		{12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00},
+		{12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00},
+		{12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00},
+		{12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00},
+		{12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00},
+		{12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00}, {12,0x00}, {18,0x00},
+	},
+	{	// 13: state 2, unpaused 4, direction 1
+		{13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00},
+		{13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00},
+		{13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00},
+		{13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00},
+		{13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00},
+		{13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00},
+		{13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00},
+		{13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00}, {13,0x00}, {19,0x00},
+	},
+	{	// 14: state 2, unpaused 5, direction 0
+		{14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00},
+		{14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00},
+		{14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00},
+		{14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00},
+		{14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00},
+		{14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00},
+		{14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00},
+		{14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00}, {14,0x00}, {20,0x00},
+	},
+	{	// 15: state 2, unpaused 5, direction 1
+		{15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00},
+		{15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00},
+		{15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00},
+		{15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00},
+		{15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00},
+		{15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00},
+		{15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00},
+		{15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00}, {15,0x00}, {21,0x00},
+	},
+	{	// 16: state 2, unpaused 6, direction 0
+		{16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00},
+		{16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00},
+		{16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00},
+		{16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00},
+		{16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00},
+		{16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00},
+		{16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00},
+		{16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00}, {16,0x00}, {22,0x00},
+	},
+	{	// 17: state 2, unpaused 6, direction 1
+		{17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00},
+		{17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00},
+		{17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00},
+		{17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00},
+		{17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00},
+		{17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00},
+		{17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00},
+		{17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00}, {17,0x00}, {23,0x00},
+	},
+	{	// 18: state 3, unpaused 4, direction 0
+		{24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00},
+		{24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00},
+		{24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00},
+		{24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00},
+		{24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00},
+		{24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00},
+		{24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00},
+		{24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00}, {24,0x01}, {18,0x00},
+	},
+	{	// 19: state 3, unpaused 4, direction 1
+		{25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00},
+		{25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00},
+		{25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00},
+		{25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00},
+		{25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00},
+		{25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00},
+		{25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00},
+		{25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00}, {25,0x01}, {19,0x00},
+	},
+	{	// 20: state 3, unpaused 5, direction 0
+		{32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00},
+		{32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00},
+		{32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00},
+		{32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00},
+		{32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00},
+		{32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00},
+		{32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00},
+		{32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00}, {32,0x02}, {20,0x00},
+	},
+	{	// 21: state 3, unpaused 5, direction 1
+		{33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00},
+		{33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00},
+		{33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00},
+		{33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00},
+		{33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00},
+		{33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00},
+		{33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00},
+		{33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00}, {33,0x03}, {21,0x00},
+	},
+	{	// 22: state 3, unpaused 6, direction 0
+		{40,0x04}, {22,0x00}, {40,0x04}, {22,0x00}, {40,0x04}, {22,0x00}, {40,0x04}, {22,0x00},
+		{40,0x04}, {22,0x00}, {40,0x04}, {22,0x00}, {40,0x04}, {22,0x00}, {40,0x04}, {22,0x00},
+		{40,0x04}, {22,0x00}, {40,0x04}, {22,0x00}, {40,0x04}, {22,0x00}, {40,0x04}, {22,0x00},
+		{40,0x04}, {22,0x00}, {40,0x04}, {22,0x00}, {40,0x04}, {22,0x00}, {40,0x04}, {22,0x00},
+		{40,0x05}, {22,0x00}, {40,0x05}, {22,0x00}, {40,0x05}, {22,0x00}, {40,0x05}, {22,0x00},
+		{40,0x05}, {22,0x00}, {40,0x05}, {22,0x00}, {40,0x05}, {22,0x00}, {40,0x05}, {22,0x00},
+		{40,0x05}, {22,0x00}, {40,0x05}, {22,0x00}, {40,0x05}, {22,0x00}, {40,0x05}, {22,0x00},
+		{40,0x05}, {22,0x00}, {40,0x05}, {22,0x00}, {40,0x05}, {22,0x00}, {40,0x05}, {22,0x00},
+	},
+	{	// 23: state 3, unpaused 6, direction 1
+		{41,0x04}, {23,0x00}, {41,0x04}, {23,0x00}, {41,0x04}, {23,0x00}, {41,0x04}, {23,0x00},
+		{41,0x04}, {23,0x00}, {41,0x04}, {23,0x00}, {41,0x04}, {23,0x00}, {41,0x04}, {23,0x00},
+		{41,0x04}, {23,0x00}, {41,0x04}, {23,0x00}, {41,0x04}, {23,0x00}, {41,0x04}, {23,0x00},
+		{41,0x04}, {23,0x00}, {41,0x04}, {23,0x00}, {41,0x04}, {23,0x00}, {41,0x04}, {23,0x00},
+		{41,0x05}, {23,0x00}, {41,0x05}, {23,0x00}, {41,0x05}, {23,0x00}, {41,0x05}, {23,0x00},
+		{41,0x05}, {23,0x00}, {41,0x05}, {23,0x00}, {41,0x05}, {23,0x00}, {41,0x05}, {23,0x00},
+		{41,0x05}, {23,0x00}, {41,0x05}, {23,0x00}, {41,0x05}, {23,0x00}, {41,0x05}, {23,0x00},
+		{41,0x05}, {23,0x00}, {41,0x05}, {23,0x00}, {41,0x05}, {23,0x00}, {41,0x05}, {23,0x00},
+	},
+	{	// 24: state 4, unpaused 4, direction 0
+		{24,0x01}, { 6,0x00}, {30,0x32}, { 6,0x00}, {31,0x33}, { 6,0x00}, {30,0x32}, { 6,0x00},
+		{24,0x01}, { 6,0x00}, {30,0x32}, { 6,0x00}, {31,0x33}, { 6,0x00}, {30,0x32}, { 6,0x00},
+		{24,0x01}, { 6,0x00}, {30,0x32}, { 6,0x00}, {31,0x33}, { 6,0x00}, {30,0x32}, { 6,0x00},
+		{24,0x01}, { 6,0x00}, {30,0x32}, { 6,0x00}, {31,0x33}, { 6,0x00}, {30,0x32}, { 6,0x00},
+		{24,0x01}, { 6,0x00}, {30,0x32}, { 6,0x00}, {31,0x33}, { 6,0x00}, {30,0x32}, { 6,0x00},
+		{24,0x01}, { 6,0x00}, {30,0x32}, { 6,0x00}, {31,0x33}, { 6,0x00}, {30,0x32}, { 6,0x00},
+		{24,0x01}, { 6,0x00}, {30,0x32}, { 6,0x00}, {31,0x33}, { 6,0x00}, {30,0x32}, { 6,0x00},
+		{24,0x01}, { 6,0x00}, {30,0x32}, { 6,0x00}, {31,0x33}, { 6,0x00}, {30,0x32}, { 6,0x00},
+	},
+	{	// 25: state 4, unpaused 4, direction 1
+		{25,0x01}, { 7,0x00}, {30,0x32}, { 7,0x00}, {31,0x33}, { 7,0x00}, {30,0x32}, { 7,0x00},
+		{25,0x01}, { 7,0x00}, {30,0x32}, { 7,0x00}, {31,0x33}, { 7,0x00}, {30,0x32}, { 7,0x00},
+		{25,0x01}, { 7,0x00}, {30,0x32}, { 7,0x00}, {31,0x33}, { 7,0x00}, {30,0x32}, { 7,0x00},
+		{25,0x01}, { 7,0x00}, {30,0x32}, { 7,0x00}, {31,0x33}, { 7,0x00}, {30,0x32}, { 7,0x00},
+		{25,0x01}, { 7,0x00}, {30,0x32}, { 7,0x00}, {31,0x33}, { 7,0x00}, {30,0x32}, { 7,0x00},
+		{25,0x01}, { 7,0x00}, {30,0x32}, { 7,0x00}, {31,0x33}, { 7,0x00}, {30,0x32}, { 7,0x00},
+		{25,0x01}, { 7,0x00}, {30,0x32}, { 7,0x00}, {31,0x33}, { 7,0x00}, {30,0x32}, { 7,0x00},
+		{25,0x01}, { 7,0x00}, {30,0x32}, { 7,0x00}, {31,0x33}, { 7,0x00}, {30,0x32}, { 7,0x00},
+	},
+	{	// 26: state 4, unpaused 5, direction 0
+		{26,0x01}, { 6,0x00}, {32,0x32}, { 6,0x00}, {33,0x33}, { 6,0x00}, {32,0x32}, { 6,0x00},
+		{26,0x01}, { 6,0x00}, {32,0x32}, { 6,0x00}, {33,0x33}, { 6,0x00}, {32,0x32}, { 6,0x00},
+		{26,0x01}, { 6,0x00}, {32,0x32}, { 6,0x00}, {33,0x33}, { 6,0x00}, {32,0x32}, { 6,0x00},
+		{26,0x01}, { 6,0x00}, {32,0x32}, { 6,0x00}, {33,0x33}, { 6,0x00}, {32,0x32}, { 6,0x00},
+		{26,0x01}, { 6,0x00}, {32,0x32}, { 6,0x00}, {33,0x33}, { 6,0x00}, {32,0x32}, { 6,0x00},
+		{26,0x01}, { 6,0x00}, {32,0x32}, { 6,0x00}, {33,0x33}, { 6,0x00}, {32,0x32}, { 6,0x00},
+		{26,0x01}, { 6,0x00}, {32,0x32}, { 6,0x00}, {33,0x33}, { 6,0x00}, {32,0x32}, { 6,0x00},
+		{26,0x01}, { 6,0x00}, {32,0x32}, { 6,0x00}, {33,0x33}, { 6,0x00}, {32,0x32}, { 6,0x00},
+	},
+	{	// 27: state 4, unpaused 5, direction 1
+		{27,0x01}, { 7,0x00}, {32,0x32}, { 7,0x00}, {33,0x33}, { 7,0x00}, {32,0x32}, { 7,0x00},
+		{27,0x01}, { 7,0x00}, {32,0x32}, { 7,0x00}, {33,0x33}, { 7,0x00}, {32,0x32}, { 7,0x00},
+		{27,0x01}, { 7,0x00}, {32,0x32}, { 7,0x00}, {33,0x33}, { 7,0x00}, {32,0x32}, { 7,0x00},
+		{27,0x01}, { 7,0x00}, {32,0x32}, { 7,0x00}, {33,0x33}, { 7,0x00}, {32,0x32}, { 7,0x00},
+		{27,0x01}, { 7,0x00}, {32,0x32}, { 7,0x00}, {33,0x33}, { 7,0x00}, {32,0x32}, { 7,0x00},
+		{27,0x01}, { 7,0x00}, {32,0x32}, { 7,0x00}, {33,0x33}, { 7,0x00}, {32,0x32}, { 7,0x00},
+		{27,0x01}, { 7,0x00}, {32,0x32}, { 7,0x00}, {33,0x33}, { 7,0x00}, {32,0x32}, { 7,0x00},
+		{27,0x01}, { 7,0x00}, {32,0x32}, { 7,0x00}, {33,0x33}, { 7,0x00}, {32,0x32}, { 7,0x00},
+	},
+	{	// 28: state 4, unpaused 6, direction 0
+		{28,0x01}, { 6,0x00}, {34,0x32}, { 6,0x00}, {35,0x33}, { 6,0x00}, {34,0x32}, { 6,0x00},
+		{28,0x01}, { 6,0x00}, {34,0x32}, { 6,0x00}, {35,0x33}, { 6,0x00}, {34,0x32}, { 6,0x00},
+		{28,0x01}, { 6,0x00}, {34,0x32}, { 6,0x00}, {35,0x33}, { 6,0x00}, {34,0x32}, { 6,0x00},
+		{28,0x01}, { 6,0x00}, {34,0x32}, { 6,0x00}, {35,0x33}, { 6,0x00}, {34,0x32}, { 6,0x00},
+		{28,0x01}, { 6,0x00}, {34,0x32}, { 6,0x00}, {35,0x33}, { 6,0x00}, {34,0x32}, { 6,0x00},
+		{28,0x01}, { 6,0x00}, {34,0x32}, { 6,0x00}, {35,0x33}, { 6,0x00}, {34,0x32}, { 6,0x00},
+		{28,0x01}, { 6,0x00}, {34,0x32}, { 6,0x00}, {35,0x33}, { 6,0x00}, {34,0x32}, { 6,0x00},
+		{28,0x01}, { 6,0x00}, {34,0x32}, { 6,0x00}, {35,0x33}, { 6,0x00}, {34,0x32}, { 6,0x00},
+	},
+	{	// 29: state 4, unpaused 6, direction 1
+		{29,0x01}, { 7,0x00}, {34,0x32}, { 7,0x00}, {35,0x33}, { 7,0x00}, {34,0x32}, { 7,0x00},
+		{29,0x01}, { 7,0x00}, {34,0x32}, { 7,0x00}, {35,0x33}, { 7,0x00}, {34,0x32}, { 7,0x00},
+		{29,0x01}, { 7,0x00}, {34,0x32}, { 7,0x00}, {35,0x33}, { 7,0x00}, {34,0x32}, { 7,0x00},
+		{29,0x01}, { 7,0x00}, {34,0x32}, { 7,0x00}, {35,0x33}, { 7,0x00}, {34,0x32}, { 7,0x00},
+		{29,0x01}, { 7,0x00}, {34,0x32}, { 7,0x00}, {35,0x33}, { 7,0x00}, {34,0x32}, { 7,0x00},
+		{29,0x01}, { 7,0x00}, {34,0x32}, { 7,0x00}, {35,0x33}, { 7,0x00}, {34,0x32}, { 7,0x00},
+		{29,0x01}, { 7,0x00}, {34,0x32}, { 7,0x00}, {35,0x33}, { 7,0x00}, {34,0x32}, { 7,0x00},
+		{29,0x01}, { 7,0x00}, {34,0x32}, { 7,0x00}, {35,0x33}, { 7,0x00}, {34,0x32}, { 7,0x00},
+	},
+	{	// 30: state 5, unpaused 4, direction 0
+		{30,0x02}, { 8,0x00}, {30,0x12}, { 8,0x00}, {31,0x13}, { 8,0x00}, {30,0x12}, { 8,0x00},
+		{36,0x04}, { 8,0x00}, {30,0x12}, { 8,0x00}, {31,0x13}, { 8,0x00}, {30,0x12}, { 8,0x00},
+		{30,0x02}, { 8,0x00}, {30,0x12}, { 8,0x00}, {31,0x13}, { 8,0x00}, {30,0x12}, { 8,0x00},
+		{36,0x04}, { 8,0x00}, {30,0x12}, { 8,0x00}, {31,0x13}, { 8,0x00}, {30,0x12}, { 8,0x00},
+		{30,0x02}, { 8,0x00}, {30,0x12}, { 8,0x00}, {31,0x13}, { 8,0x00}, {30,0x12}, { 8,0x00},
+		{36,0x05}, { 8,0x00}, {30,0x12}, { 8,0x00}, {31,0x13}, { 8,0x00}, {30,0x12}, { 8,0x00},
+		{30,0x02}, { 8,0x00}, {30,0x12}, { 8,0x00}, {31,0x13}, { 8,0x00}, {30,0x12}, { 8,0x00},
+		{36,0x05}, { 8,0x00}, {30,0x12}, { 8,0x00}, {31,0x13}, { 8,0x00}, {30,0x12}, { 8,0x00},
+	},
+	{	// 31: state 5, unpaused 4, direction 1
+		{31,0x03}, { 9,0x00}, {30,0x12}, { 9,0x00}, {31,0x13}, { 9,0x00}, {30,0x12}, { 9,0x00},
+		{37,0x04}, { 9,0x00}, {30,0x12}, { 9,0x00}, {31,0x13}, { 9,0x00}, {30,0x12}, { 9,0x00},
+		{31,0x03}, { 9,0x00}, {30,0x12}, { 9,0x00}, {31,0x13}, { 9,0x00}, {30,0x12}, { 9,0x00},
+		{37,0x04}, { 9,0x00}, {30,0x12}, { 9,0x00}, {31,0x13}, { 9,0x00}, {30,0x12}, { 9,0x00},
+		{31,0x03}, { 9,0x00}, {30,0x12}, { 9,0x00}, {31,0x13}, { 9,0x00}, {30,0x12}, { 9,0x00},
+		{37,0x05}, { 9,0x00}, {30,0x12}, { 9,0x00}, {31,0x13}, { 9,0x00}, {30,0x12}, { 9,0x00},
+		{31,0x03}, { 9,0x00}, {30,0x12}, { 9,0x00}, {31,0x13}, { 9,0x00}, {30,0x12}, { 9,0x00},
+		{37,0x05}, { 9,0x00}, {30,0x12}, { 9,0x00}, {31,0x13}, { 9,0x00}, {30,0x12}, { 9,0x00},
+	},
+	{	// 32: state 5, unpaused 5, direction 0
+		{32,0x02}, { 8,0x00}, {32,0x12}, { 8,0x00}, {33,0x13}, { 8,0x00}, {32,0x12}, { 8,0x00},
+		{38,0x04}, { 8,0x00}, {32,0x12}, { 8,0x00}, {33,0x13}, { 8,0x00}, {32,0x12}, { 8,0x00},
+		{32,0x02}, { 8,0x00}, {32,0x12}, { 8,0x00}, {33,0x13}, { 8,0x00}, {32,0x12}, { 8,0x00},
+		{38,0x04}, { 8,0x00}, {32,0x12}, { 8,0x00}, {33,0x13}, { 8,0x00}, {32,0x12}, { 8,0x00},
+		{32,0x02}, { 8,0x00}, {32,0x12}, { 8,0x00}, {33,0x13}, { 8,0x00}, {32,0x12}, { 8,0x00},
+		{38,0x05}, { 8,0x00}, {32,0x12}, { 8,0x00}, {33,0x13}, { 8,0x00}, {32,0x12}, { 8,0x00},
+		{32,0x02}, { 8,0x00}, {32,0x12}, { 8,0x00}, {33,0x13}, { 8,0x00}, {32,0x12}, { 8,0x00},
+		{38,0x05}, { 8,0x00}, {32,0x12}, { 8,0x00}, {33,0x13}, { 8,0x00}, {32,0x12}, { 8,0x00},
+	},
+	{	// 33: state 5, unpaused 5, direction 1
+		{33,0x03}, { 9,0x00}, {32,0x12}, { 9,0x00}, {33,0x13}, { 9,0x00}, {32,0x12}, { 9,0x00},
+		{39,0x04}, { 9,0x00}, {32,0x12}, { 9,0x00}, {33,0x13}, { 9,0x00}, {32,0x12}, { 9,0x00},
+		{33,0x03}, { 9,0x00}, {32,0x12}, { 9,0x00}, {33,0x13}, { 9,0x00}, {32,0x12}, { 9,0x00},
+		{39,0x04}, { 9,0x00}, {32,0x12}, { 9,0x00}, {33,0x13}, { 9,0x00}, {32,0x12}, { 9,0x00},
+		{33,0x03}, { 9,0x00}, {32,0x12}, { 9,0x00}, {33,0x13}, { 9,0x00}, {32,0x12}, { 9,0x00},
+		{39,0x05}, { 9,0x00}, {32,0x12}, { 9,0x00}, {33,0x13}, { 9,0x00}, {32,0x12}, { 9,0x00},
+		{33,0x03}, { 9,0x00}, {32,0x12}, { 9,0x00}, {33,0x13}, { 9,0x00}, {32,0x12}, { 9,0x00},
+		{39,0x05}, { 9,0x00}, {32,0x12}, { 9,0x00}, {33,0x13}, { 9,0x00}, {32,0x12}, { 9,0x00},
+	},
+	{	// 34: state 5, unpaused 6, direction 0
+		{34,0x02}, { 8,0x00}, {34,0x12}, { 8,0x00}, {35,0x13}, { 8,0x00}, {34,0x12}, { 8,0x00},
+		{40,0x04}, { 8,0x00}, {34,0x12}, { 8,0x00}, {35,0x13}, { 8,0x00}, {34,0x12}, { 8,0x00},
+		{34,0x02}, { 8,0x00}, {34,0x12}, { 8,0x00}, {35,0x13}, { 8,0x00}, {34,0x12}, { 8,0x00},
+		{40,0x04}, { 8,0x00}, {34,0x12}, { 8,0x00}, {35,0x13}, { 8,0x00}, {34,0x12}, { 8,0x00},
+		{34,0x02}, { 8,0x00}, {34,0x12}, { 8,0x00}, {35,0x13}, { 8,0x00}, {34,0x12}, { 8,0x00},
+		{40,0x05}, { 8,0x00}, {34,0x12}, { 8,0x00}, {35,0x13}, { 8,0x00}, {34,0x12}, { 8,0x00},
+		{34,0x02}, { 8,0x00}, {34,0x12}, { 8,0x00}, {35,0x13}, { 8,0x00}, {34,0x12}, { 8,0x00},
+		{40,0x05}, { 8,0x00}, {34,0x12}, { 8,0x00}, {35,0x13}, { 8,0x00}, {34,0x12}, { 8,0x00},
+	},
+	{	// 35: state 5, unpaused 6, direction 1
+		{35,0x03}, { 9,0x00}, {34,0x12}, { 9,0x00}, {35,0x13}, { 9,0x00}, {34,0x12}, { 9,0x00},
+		{41,0x04}, { 9,0x00}, {34,0x12}, { 9,0x00}, {35,0x13}, { 9,0x00}, {34,0x12}, { 9,0x00},
+		{35,0x03}, { 9,0x00}, {34,0x12}, { 9,0x00}, {35,0x13}, { 9,0x00}, {34,0x12}, { 9,0x00},
+		{41,0x04}, { 9,0x00}, {34,0x12}, { 9,0x00}, {35,0x13}, { 9,0x00}, {34,0x12}, { 9,0x00},
+		{35,0x03}, { 9,0x00}, {34,0x12}, { 9,0x00}, {35,0x13}, { 9,0x00}, {34,0x12}, { 9,0x00},
+		{41,0x05}, { 9,0x00}, {34,0x12}, { 9,0x00}, {35,0x13}, { 9,0x00}, {34,0x12}, { 9,0x00},
+		{35,0x03}, { 9,0x00}, {34,0x12}, { 9,0x00}, {35,0x13}, { 9,0x00}, {34,0x12}, { 9,0x00},
+		{41,0x05}, { 9,0x00}, {34,0x12}, { 9,0x00}, {35,0x13}, { 9,0x00}, {34,0x12}, { 9,0x00},
+	},
+	{	// 36: state 6, unpaused 4, direction 0
+		{36,0x04}, {10,0x00}, {30,0x32}, {10,0x00}, {31,0x33}, {10,0x00}, {30,0x32}, {10,0x00},
+		{36,0x04}, {10,0x00}, {30,0x32}, {10,0x00}, {31,0x33}, {10,0x00}, {30,0x32}, {10,0x00},
+		{24,0x01}, {10,0x00}, {30,0x32}, {10,0x00}, {31,0x33}, {10,0x00}, {30,0x32}, {10,0x00},
+		{24,0x01}, {10,0x00}, {30,0x32}, {10,0x00}, {31,0x33}, {10,0x00}, {30,0x32}, {10,0x00},
+		{36,0x05}, {10,0x00}, {30,0x32}, {10,0x00}, {31,0x33}, {10,0x00}, {30,0x32}, {10,0x00},
+		{36,0x05}, {10,0x00}, {30,0x32}, {10,0x00}, {31,0x33}, {10,0x00}, {30,0x32}, {10,0x00},
+		{24,0x01}, {10,0x00}, {30,0x32}, {10,0x00}, {31,0x33}, {10,0x00}, {30,0x32}, {10,0x00},
+		{24,0x01}, {10,0x00}, {30,0x32}, {10,0x00}, {31,0x33}, {10,0x00}, {30,0x32}, {10,0x00},
+	},
+	{	// 37: state 6, unpaused 4, direction 1
+		{37,0x04}, {11,0x00}, {30,0x32}, {11,0x00}, {31,0x33}, {11,0x00}, {30,0x32}, {11,0x00},
+		{37,0x04}, {11,0x00}, {30,0x32}, {11,0x00}, {31,0x33}, {11,0x00}, {30,0x32}, {11,0x00},
+		{25,0x01}, {11,0x00}, {30,0x32}, {11,0x00}, {31,0x33}, {11,0x00}, {30,0x32}, {11,0x00},
+		{25,0x01}, {11,0x00}, {30,0x32}, {11,0x00}, {31,0x33}, {11,0x00}, {30,0x32}, {11,0x00},
+		{37,0x05}, {11,0x00}, {30,0x32}, {11,0x00}, {31,0x33}, {11,0x00}, {30,0x32}, {11,0x00},
+		{37,0x05}, {11,0x00}, {30,0x32}, {11,0x00}, {31,0x33}, {11,0x00}, {30,0x32}, {11,0x00},
+		{25,0x01}, {11,0x00}, {30,0x32}, {11,0x00}, {31,0x33}, {11,0x00}, {30,0x32}, {11,0x00},
+		{25,0x01}, {11,0x00}, {30,0x32}, {11,0x00}, {31,0x33}, {11,0x00}, {30,0x32}, {11,0x00},
+	},
+	{	// 38: state 6, unpaused 5, direction 0
+		{38,0x04}, {10,0x00}, {32,0x32}, {10,0x00}, {33,0x33}, {10,0x00}, {32,0x32}, {10,0x00},
+		{38,0x04}, {10,0x00}, {32,0x32}, {10,0x00}, {33,0x33}, {10,0x00}, {32,0x32}, {10,0x00},
+		{26,0x01}, {10,0x00}, {32,0x32}, {10,0x00}, {33,0x33}, {10,0x00}, {32,0x32}, {10,0x00},
+		{26,0x01}, {10,0x00}, {32,0x32}, {10,0x00}, {33,0x33}, {10,0x00}, {32,0x32}, {10,0x00},
+		{38,0x05}, {10,0x00}, {32,0x32}, {10,0x00}, {33,0x33}, {10,0x00}, {32,0x32}, {10,0x00},
+		{38,0x05}, {10,0x00}, {32,0x32}, {10,0x00}, {33,0x33}, {10,0x00}, {32,0x32}, {10,0x00},
+		{26,0x01}, {10,0x00}, {32,0x32}, {10,0x00}, {33,0x33}, {10,0x00}, {32,0x32}, {10,0x00},
+		{26,0x01}, {10,0x00}, {32,0x32}, {10,0x00}, {33,0x33}, {10,0x00}, {32,0x32}, {10,0x00},
+	},
+	{	// 39: state 6, unpaused 5, direction 1
+		{39,0x04}, {11,0x00}, {32,0x32}, {11,0x00}, {33,0x33}, {11,0x00}, {32,0x32}, {11,0x00},
+		{39,0x04}, {11,0x00}, {32,0x32}, {11,0x00}, {33,0x33}, {11,0x00}, {32,0x32}, {11,0x00},
+		{27,0x01}, {11,0x00}, {32,0x32}, {11,0x00}, {33,0x33}, {11,0x00}, {32,0x32}, {11,0x00},
+		{27,0x01}, {11,0x00}, {32,0x32}, {11,0x00}, {33,0x33}, {11,0x00}, {32,0x32}, {11,0x00},
+		{39,0x05}, {11,0x00}, {32,0x32}, {11,0x00}, {33,0x33}, {11,0x00}, {32,0x32}, {11,0x00},
+		{39,0x05}, {11,0x00}, {32,0x32}, {11,0x00}, {33,0x33}, {11,0x00}, {32,0x32}, {11,0x00},
+		{27,0x01}, {11,0x00}, {32,0x32}, {11,0x00}, {33,0x33}, {11,0x00}, {32,0x32}, {11,0x00},
+		{27,0x01}, {11,0x00}, {32,0x32}, {11,0x00}, {33,0x33}, {11,0x00}, {32,0x32}, {11,0x00},
+	},
+	{	// 40: state 6, unpaused 6, direction 0
+		{40,0x04}, {10,0x00}, {34,0x32}, {10,0x00}, {35,0x33}, {10,0x00}, {34,0x32}, {10,0x00},
+		{40,0x04}, {10,0x00}, {34,0x32}, {10,0x00}, {35,0x33}, {10,0x00}, {34,0x32}, {10,0x00},
+		{28,0x01}, {10,0x00}, {34,0x32}, {10,0x00}, {35,0x33}, {10,0x00}, {34,0x32}, {10,0x00},
+		{28,0x01}, {10,0x00}, {34,0x32}, {10,0x00}, {35,0x33}, {10,0x00}, {34,0x32}, {10,0x00},
+		{40,0x05}, {10,0x00}, {34,0x32}, {10,0x00}, {35,0x33}, {10,0x00}, {34,0x32}, {10,0x00},
+		{40,0x05}, {10,0x00}, {34,0x32}, {10,0x00}, {35,0x33}, {10,0x00}, {34,0x32}, {10,0x00},
+		{28,0x01}, {10,0x00}, {34,0x32}, {10,0x00}, {35,0x33}, {10,0x00}, {34,0x32}, {10,0x00},
+		{28,0x01}, {10,0x00}, {34,0x32}, {10,0x00}, {35,0x33}, {10,0x00}, {34,0x32}, {10,0x00},
+	},
+	{	// 41: state 6, unpaused 6, direction 1
+		{41,0x04}, {11,0x00}, {34,0x32}, {11,0x00}, {35,0x33}, {11,0x00}, {34,0x32}, {11,0x00},
+		{41,0x04}, {11,0x00}, {34,0x32}, {11,0x00}, {35,0x33}, {11,0x00}, {34,0x32}, {11,0x00},
+		{29,0x01}, {11,0x00}, {34,0x32}, {11,0x00}, {35,0x33}, {11,0x00}, {34,0x32}, {11,0x00},
+		{29,0x01}, {11,0x00}, {34,0x32}, {11,0x00}, {35,0x33}, {11,0x00}, {34,0x32}, {11,0x00},
+		{41,0x05}, {11,0x00}, {34,0x32}, {11,0x00}, {35,0x33}, {11,0x00}, {34,0x32}, {11,0x00},
+		{41,0x05}, {11,0x00}, {34,0x32}, {11,0x00}, {35,0x33}, {11,0x00}, {34,0x32}, {11,0x00},
+		{29,0x01}, {11,0x00}, {34,0x32}, {11,0x00}, {35,0x33}, {11,0x00}, {34,0x32}, {11,0x00},
+		{29,0x01}, {11,0x00}, {34,0x32}, {11,0x00}, {35,0x33}, {11,0x00}, {34,0x32}, {11,0x00},
+	},
+};
+
+#endif // IROBOTNAVSTATECHARTTABLEDATA_H_
@@ -0,0 +1,109 @@
+/*
+ *	irobotNavTableStatechart.c
+ *
+ *	irobotNavStatechart.c, compiled offline into a lookup table by the
+ *	tablegen target. Each step reduces the inputs to a bitmask and loads the
+ *	next state and outputs from the table, instead of evaluating the
+ *	cascade of transitions; the behavior is the same tick for tick.
+ *
+ *	The context layout and tag are those of irobotNavStatechart.c, so the
+ *	two can be hot-swapped for each other.
+ *
+ */
+
+
+#include "irobotNavigationStatechart.h"
+#include "irobotNavStatechartTable.h"
+#include "irobotNavStatechartTableData.h"
+#include "irobotStatechartCoverage.h"
+#include <string.h>
+
+// statechart state; exported through the context functions
+static navTableState_t		tableState = {0, 0, 0};			// INITIAL, unpaused in DRIVE, obstacle LEFT
+
+// transition coverage, by program state, as in irobotNavStatechart.c
+static const char * const stateNames[] = {
+	"INITIAL",
+	"PAUSE_WAIT_BUTTON_RELEASE",
+	"UNPAUSE_WAIT_BUTTON_PRESS",
+	"UNPAUSE_WAIT_BUTTON_RELEASE",
+	"DRIVE",
+	"AVOID",
+	"REORIENT"
+};
+STATECHART_COVERAGE_DEFINE("irobotNavTableStatechart", stateNames);
+
+#define PROGRAM_STATE(index)	((index) / (NAVTABLE_RUN_STATES * NAVTABLE_DIRECTIONS))
+
+uint32_t IROBOT_STATECHART_SYMBOL(irobotNavTableStatechart, )(
+	const int32_t 				netDistance,
+	const int32_t 				netAngle,
+	const irobotSensorGroup6_t	sensors,
+	const accelerometer_t		accelAxes,
+	const bool					isSimulator,
+	int16_t * const 			pRightWheelSpeed,
+	int16_t * const 			pLeftWheelSpeed
+){
+	uint32_t					periodMs;						// period until the next execution, in ms
+
+	STATECHART_COVERAGE_FROM(PROGRAM_STATE(tableState.index));
+	periodMs = navTableStep(navTable, navTableOutputs, &tableState, netDistance, netAngle, sensors, pRightWheelSpeed, pLeftWheelSpeed);
+	STATECHART_COVERAGE_TO(PROGRAM_STATE(tableState.index));
+
+	return periodMs;
+}
+
+size_t IROBOT_STATECHART_SYMBOL(irobotNavTableStatechart, ContextSave)(void * const pContext, const size_t contextSize){
+	navTableContext_t context;
+
+	if(!pContext || contextSize < sizeof(context)){
+		return 0;
+	}
+
+	context.tag = NAVTABLE_CONTEXT_TAG;
+	navTableStateFromIndex(tableState.index, &context.state, &context.unpausedState, &context.obstacleDirection);
+	context.distanceAtManeuverStart = tableState.distanceAtManeuverStart;
+	context.angleAtManeuverStart = tableState.angleAtManeuverStart;
+	memcpy(pContext, &context, sizeof(context));
+
+	return sizeof(context);
+}
+
+bool IROBOT_STATECHART_SYMBOL(irobotNavTableStatechart, ContextRestore)(const void * const pContext, const size_t contextSize){
+	navTableContext_t	context;
+	uint32_t			index;
+
+	if(!pContext || contextSize != sizeof(context)){
+		return false;
+	}
+
+	memcpy(&context, pContext, sizeof(context));
+	index = navTableStateIndex(context.state, context.unpausedState, context.obstacleDirection);
+	if(context.tag != NAVTABLE_CONTEXT_TAG || index >= NAVTABLE_STATES){
+		return false;
+	}
+
+	tableState.index = index;
+	tableState.distanceAtManeuverStart = context.distanceAtManeuverStart;
+	tableState.angleAtManeuverStart = context.angleAtManeuverStart;
+
+	return true;
+}
+
+bool IROBOT_STATECHART_SYMBOL(irobotNavTableStatechart, Maneuver)(irobotManeuver_t * const pManeuver){
+	switch(PROGRAM_STATE(tableState.index)){
+	case NAVTABLE_AVOID:
+		// backing up until the avoid distance
+		pManeuver->end = MANEUVER_DISTANCE;
+		pManeuver->target = tableState.distanceAtManeuverStart - NAVTABLE_AVOID_DISTANCE;
+		return true;
+	case NAVTABLE_REORIENT:
+		// turning back to the orientation at the first obstacle
+		pManeuver->end = MANEUVER_ANGLE;
+		pManeuver->target = tableState.angleAtManeuverStart;
+		return true;
+	default:
+		pManeuver->end = MANEUVER_NONE;
+		return false;
+	}
+}